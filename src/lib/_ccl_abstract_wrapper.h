@@ -34,6 +34,7 @@
 #include "ccl_oclversions.h"
 #include "ccl_common.h"
 #include "ccl_errors.h"
+#include "ccl_abstract_wrapper.h"
 
 /**
  * @internal
@@ -73,6 +74,59 @@ struct ccl_wrapper {
 
 };
 
+/**
+ * @internal
+ *
+ * @brief Inline variant of ccl_wrapper_unwrap() for use inside the
+ * library.
+ *
+ * The public ccl_wrapper_unwrap() is an exported function, so calls to
+ * it from other translation units cannot be inlined; inside the
+ * library, where the wrapper layout is known, this variant compiles
+ * down to a single pointer load.
+ *
+ * @param[in] wrapper The wrapper object.
+ * @return The wrapped OpenCL object.
+ * */
+static inline void * ccl_wrapper_unwrap_inline(CCLWrapper * wrapper) {
+    return wrapper->cl_object;
+}
+
+/**
+ * @internal
+ *
+ * @brief Inline variant of ccl_wrapper_ref() for use inside the
+ * library. Compiles down to a single atomic increment.
+ *
+ * Taking a reference needs no ordering with respect to other memory
+ * operations — only the final decrement, which publishes the object
+ * for destruction, does (and g_atomic_int_dec_and_test() in
+ * ccl_wrapper_unref() provides it). Where the compiler exposes atomic
+ * builtins the increment is therefore relaxed, avoiding the full
+ * barrier GLib's sequentially consistent atomics imply on weakly
+ * ordered architectures.
+ *
+ * @param[in] wrapper The wrapper object.
+ * */
+static inline void ccl_wrapper_ref_inline(CCLWrapper * wrapper) {
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_fetch_add(&wrapper->ref_count, 1, __ATOMIC_RELAXED);
+#else
+    g_atomic_int_inc(&wrapper->ref_count);
+#endif
+}
+
+/* Within the library, route the public accessors (and the per-class
+ * ccl_*_unwrap()/ccl_*_ref() macros which expand to them) to the
+ * inline variants. Translation units which define the out-of-line
+ * functions set CCL_NO_INLINE_HOT before including this header. When
+ * object lifetime debugging is enabled, the out-of-line functions are
+ * kept so that referencing is logged. */
+#if !defined(CCL_NO_INLINE_HOT) && !defined(CCL_DEBUG_OBJ_LIFETIME)
+#define ccl_wrapper_unwrap ccl_wrapper_unwrap_inline
+#define ccl_wrapper_ref ccl_wrapper_ref_inline
+#endif
+
 /**
  * @internal
  *
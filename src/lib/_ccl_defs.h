@@ -80,6 +80,44 @@
  * by CCL_STRD. */
 #define G_ERR_DEBUG_STR CCL_STRD
 
+/* Error conditions in the goto-based error-handling macros below are
+ * wrapped in G_UNLIKELY, so that compilers predict the success path and
+ * lay out the error-construction code away from it. */
+
+/* Marks rarely-executed helper functions as cold, so compilers place
+ * them in a separate text section and optimize them for size. */
+#if __GNUC__ >= 4 || defined(__clang__)
+    #define CCL_COLD __attribute__((cold))
+#else
+    #define CCL_COLD
+#endif
+
+/* Prevents a function from being inlined, keeping its body out of the
+ * callers — used together with CCL_COLD for error-reporting helpers
+ * called from hot loops. */
+#if __GNUC__ >= 4 || defined(__clang__)
+    #define CCL_NOINLINE __attribute__((noinline))
+#else
+    #define CCL_NOINLINE
+#endif
+
+/* Parameter validation for hot-path functions. By default these forward
+ * to GLib's g_return(_val)_if_fail(), which logs a critical warning with
+ * the failing expression. Building with CCL_NDEBUG replaces them with
+ * plain unlikely-hinted early returns, dropping the call into GLib's
+ * logging machinery from functions invoked per kernel argument or per
+ * enqueue. The checks themselves are kept: misuse still returns cleanly
+ * instead of invoking undefined behavior, it just does so silently. */
+#ifdef CCL_NDEBUG
+    #define ccl_return_if_fail(expr) \
+        do { if (G_UNLIKELY(!(expr))) return; } while (0)
+    #define ccl_return_val_if_fail(expr, val) \
+        do { if (G_UNLIKELY(!(expr))) return (val); } while (0)
+#else
+    #define ccl_return_if_fail(expr) g_return_if_fail(expr)
+    #define ccl_return_val_if_fail(expr, val) g_return_val_if_fail(expr, val)
+#endif
+
 /**
  * If error is detected (`error_code != no_error_code`),
  * create an error object (CCLErr) and go to the specified label.
@@ -95,7 +133,7 @@
  * */
 #define ccl_if_err_create_goto( \
     err, quark, error_condition, error_code, label, msg, ...) \
-    if (error_condition) { \
+    if (G_UNLIKELY(error_condition)) { \
         g_set_error(&(err), (quark), (error_code), (msg), ##__VA_ARGS__); \
         g_debug(G_ERR_DEBUG_STR); \
         goto label; \
@@ -109,7 +147,7 @@
  * @param[in] label Label to goto if error is detected.
  * */
 #define ccl_if_err_goto(err, label) \
-    if ((err) != NULL) { \
+    if (G_UNLIKELY((err) != NULL)) { \
         g_debug(G_ERR_DEBUG_STR); \
         goto label; \
     }
@@ -123,7 +161,7 @@
  * @param[in] label Label to goto if error is detected.
  * */
 #define ccl_if_err_propagate_goto(err_dest, err_src, label) \
-    if ((err_src) != NULL) { \
+    if (G_UNLIKELY((err_src) != NULL)) { \
         g_debug(G_ERR_DEBUG_STR); \
         g_propagate_error((err_dest), (err_src)); \
         err_src = NULL; \
@@ -26,6 +26,13 @@
  * @copyright [GNU Lesser General Public License version 3 (LGPLv3)](http://www.gnu.org/licenses/lgpl.html)
  * */
 
+/* This translation unit defines the out-of-line ccl_wrapper_unwrap()
+ * and ccl_wrapper_ref() functions, so it must not have them replaced
+ * by their inline variants. */
+#define CCL_NO_INLINE_HOT
+
+#include <string.h>
+
 #include "ccl_abstract_wrapper.h"
 #include "_ccl_abstract_wrapper.h"
 #include "_ccl_kernel_wrapper.h"
@@ -34,6 +41,148 @@
 /* Generic function pointer for OpenCL clget**Info() functions. */
 typedef cl_int (*ccl_wrapper_info_fp)(void);
 
+/**
+ * @internal
+ *
+ * @brief Maximum number of distinct wrapper sizes tracked by the
+ * per-thread wrapper freelists. One bin per concrete wrapper class is
+ * plenty.
+ */
+#define CCL_WRAPPER_POOL_BINS 12
+
+/**
+ * @internal
+ *
+ * @brief Maximum number of freed wrappers kept per freelist bin.
+ * Further frees go back to the slice allocator.
+ */
+#define CCL_WRAPPER_POOL_DEPTH 32
+
+/**
+ * @internal
+ *
+ * @brief Per-thread pool of freed wrapper objects, binned by size.
+ * Destroyed wrappers are pushed here and popped by the next
+ * ccl_wrapper_new() of the same size, skipping the allocator and its
+ * per-size magazine overhead on create/destroy cycles. Freed wrappers
+ * are linked through their first pointer-sized bytes.
+ */
+struct ccl_wrapper_pool {
+    struct {
+        size_t size;
+        guint depth;
+        void * head;
+    } bins[CCL_WRAPPER_POOL_BINS];
+    guint num_bins;
+};
+
+/* Destructor for the per-thread wrapper pool. */
+static void ccl_wrapper_pool_destroy(gpointer data);
+
+/* Per-thread wrapper pool. */
+static GPrivate ccl_wrapper_pool_private =
+    G_PRIVATE_INIT(ccl_wrapper_pool_destroy);
+
+/**
+ * @internal
+ *
+ * @brief Release a per-thread wrapper pool and the freed wrappers it
+ * holds. Invoked when a thread which used wrappers terminates.
+ *
+ * @param[in] data The pool to release.
+ * */
+static void ccl_wrapper_pool_destroy(gpointer data) {
+
+    struct ccl_wrapper_pool * pool = (struct ccl_wrapper_pool *) data;
+
+    for (guint i = 0; i < pool->num_bins; ++i) {
+        void * head = pool->bins[i].head;
+        while (head != NULL) {
+            void * next = *(void **) head;
+            g_slice_free1(pool->bins[i].size, head);
+            head = next;
+        }
+    }
+    g_slice_free(struct ccl_wrapper_pool, pool);
+}
+
+/**
+ * @internal
+ *
+ * @brief Allocate a zeroed wrapper object of the given size, reusing a
+ * previously freed wrapper from the per-thread pool when one is
+ * available.
+ *
+ * @param[in] size Size of the wrapper object.
+ * @return A zeroed wrapper object.
+ * */
+static void * ccl_wrapper_alloc(size_t size) {
+
+    struct ccl_wrapper_pool * pool =
+        g_private_get(&ccl_wrapper_pool_private);
+
+    if (pool != NULL) {
+        for (guint i = 0; i < pool->num_bins; ++i) {
+            if ((pool->bins[i].size == size)
+                && (pool->bins[i].head != NULL)) {
+                void * w = pool->bins[i].head;
+                pool->bins[i].head = *(void **) w;
+                pool->bins[i].depth--;
+                memset(w, 0, size);
+                return w;
+            }
+        }
+    }
+
+    return g_slice_alloc0(size);
+}
+
+/**
+ * @internal
+ *
+ * @brief Release a wrapper object of the given size, keeping it in the
+ * per-thread pool for reuse unless the respective bin is full.
+ *
+ * @param[in] wrapper The wrapper object to release.
+ * @param[in] size Size of the wrapper object.
+ * */
+static void ccl_wrapper_free(void * wrapper, size_t size) {
+
+    struct ccl_wrapper_pool * pool =
+        g_private_get(&ccl_wrapper_pool_private);
+
+    /* Create the pool on this thread's first wrapper release. */
+    if (pool == NULL) {
+        pool = g_slice_new0(struct ccl_wrapper_pool);
+        g_private_set(&ccl_wrapper_pool_private, pool);
+    }
+
+    /* Find or create the bin for this wrapper size. */
+    for (guint i = 0; i < pool->num_bins; ++i) {
+        if (pool->bins[i].size == size) {
+            if (pool->bins[i].depth >= CCL_WRAPPER_POOL_DEPTH) {
+                g_slice_free1(size, wrapper);
+            } else {
+                *(void **) wrapper = pool->bins[i].head;
+                pool->bins[i].head = wrapper;
+                pool->bins[i].depth++;
+            }
+            return;
+        }
+    }
+    if (pool->num_bins < CCL_WRAPPER_POOL_BINS) {
+        guint i = pool->num_bins++;
+        pool->bins[i].size = size;
+        pool->bins[i].depth = 1;
+        *(void **) wrapper = NULL;
+        pool->bins[i].head = wrapper;
+        return;
+    }
+
+    /* No bin available, free the wrapper directly. */
+    g_slice_free1(size, wrapper);
+}
+
 /* Table of all existing wrappers. */
 static GHashTable * wrappers = NULL;
 /* Define lock for synchronizing access to table of all existing wrappers. */
@@ -141,7 +290,7 @@ CCLWrapper * ccl_wrapper_new(CCLClass class, void * cl_object, size_t size) {
     if (w == NULL) {
 
         /* Wrapper doesn't yet exist, create it. */
-        w = (CCLWrapper *) g_slice_alloc0(size);
+        w = (CCLWrapper *) ccl_wrapper_alloc(size);
         w->class = class;
         w->cl_object = cl_object;
 
@@ -251,8 +400,9 @@ cl_bool ccl_wrapper_unref(CCLWrapper * wrapper, size_t size,
         if (rel_fields_fun != NULL)
             rel_fields_fun(wrapper);
 
-        /* Destroy wrapper. */
-        g_slice_free1(size, wrapper);
+        /* Destroy wrapper, keeping it in the per-thread pool for
+         * reuse. */
+        ccl_wrapper_free(wrapper, size);
 
     }
 
@@ -616,6 +766,86 @@ void * ccl_wrapper_get_info_value(CCLWrapper * wrapper1,
     return diw != NULL ? diw->value : NULL;
 }
 
+/**
+ * Get pointer to information value, caching the information object in
+ * a caller-provided slot.
+ *
+ * This function should not be directly invoked in most circumstances.
+ * Use the ::ccl_wrapper_get_info_scalar_cached() macro instead.
+ *
+ * On the first invocation the information is fetched with
+ * ccl_wrapper_get_info() and, if successful, the information object is
+ * stored in `slot`. Subsequent invocations return the value directly
+ * from the slot, skipping the information table lookup. The slot
+ * caches the information of a single wrapper object, so one slot must
+ * be used per wrapper.
+ *
+ * @public @memberof ccl_wrapper
+ *
+ * @param[in] wrapper1 The wrapper object to query.
+ * @param[in] wrapper2 A second wrapper object, required in some
+ * queries.
+ * @param[in] param_name Name of information/parameter to get value of.
+ * @param[in] min_size Minimum size of returned value in case of error.
+ * @param[in] info_type Type of information query to perform.
+ * @param[in,out] slot Location of a ::CCLWrapperInfo* variable,
+ * initialized to `NULL`, which caches the information object between
+ * invocations.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return A pointer to the requested information value. This
+ * value will be automatically freed when the wrapper object is
+ * destroyed. If an error occurs, either `NULL` (if `min_size == 0`), or
+ * a pointer to a `min_size`d zero value is returned (if `min_size > 0`).
+ * */
+CCL_EXPORT
+void * ccl_wrapper_get_info_value_cached(CCLWrapper * wrapper1,
+    CCLWrapper * wrapper2, cl_uint param_name, size_t min_size,
+    CCLInfo info_type, CCLWrapperInfo ** slot, CCLErr ** err) {
+
+    /* Make sure err is NULL or it is not set. */
+    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+
+    /* Make sure wrapper1 is not NULL. */
+    g_return_val_if_fail(wrapper1 != NULL, NULL);
+
+    /* Make sure slot is not NULL. */
+    g_return_val_if_fail(slot != NULL, NULL);
+
+    /* Information object. */
+    CCLWrapperInfo * info;
+
+    /* Internal error handling object. */
+    CCLErr * err_internal = NULL;
+
+    /* Fast path: return the value cached by a previous invocation. */
+    if (*slot != NULL)
+        return (*slot)->value;
+
+    /* Slow path: perform the query, allowing the wrapper information
+     * cache to be used. */
+    info = ccl_wrapper_get_info(wrapper1, wrapper2, param_name,
+        min_size, info_type, CL_TRUE, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Cache the information object for subsequent invocations. Only
+     * successful queries are cached. */
+    *slot = info;
+
+    /* If we got here, everything is OK. */
+    g_assert(err == NULL || *err == NULL);
+    goto finish;
+
+error_handler:
+    /* If we got here there was an error, verify that it is so. */
+    g_assert(err == NULL || *err != NULL);
+
+finish:
+
+    /* Return value if information object is not NULL. */
+    return info != NULL ? info->value : NULL;
+}
+
 /**
  * Get information size.
  *
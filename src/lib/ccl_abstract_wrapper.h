@@ -63,7 +63,7 @@ int ccl_wrapper_ref_count(CCLWrapper * wrapper);
 
 /* Get the wrapped OpenCL object. */
 CCL_EXPORT
-void * ccl_wrapper_unwrap(CCLWrapper * wrapper);
+void * ccl_wrapper_unwrap(CCLWrapper * wrapper) G_GNUC_PURE;
 
 /* Get information about any wrapped OpenCL object. */
 CCL_EXPORT
@@ -77,6 +77,49 @@ void * ccl_wrapper_get_info_value(CCLWrapper * wrapper1,
     CCLWrapper * wrapper2, cl_uint param_name, size_t min_size,
     CCLInfo info_type, cl_bool use_cache, CCLErr ** err);
 
+/* Get pointer to information value, caching the information object in
+ * a caller-provided slot. */
+CCL_EXPORT
+void * ccl_wrapper_get_info_value_cached(CCLWrapper * wrapper1,
+    CCLWrapper * wrapper2, cl_uint param_name, size_t min_size,
+    CCLInfo info_type, CCLWrapperInfo ** slot, CCLErr ** err);
+
+/**
+ * Macro which returns a scalar information value, caching the
+ * underlying information object in a caller-provided slot.
+ *
+ * This macro works like the class-specific `ccl_*_get_info_scalar()`
+ * macros, but after the first invocation the value is returned
+ * directly from `slot`, skipping the information table lookup. Useful
+ * for queries repeated in tight loops, e.g. `CL_KERNEL_WORK_GROUP_SIZE`
+ * in a dispatch loop.
+ *
+ * @attention The slot caches the information of a single wrapper
+ * object. Use one slot per wrapper, and reset the slot to `NULL` if it
+ * may outlive the wrapper.
+ *
+ * @relates ccl_wrapper
+ *
+ * @param[in] wrapper1 The wrapper object to query.
+ * @param[in] wrapper2 A second wrapper object, required in some
+ * queries, `NULL` otherwise.
+ * @param[in] param_name Name of information/parameter to get value of.
+ * @param[in] param_type Type of parameter (e.g. `cl_uint`, `size_t`,
+ * etc.).
+ * @param[in] info_type Type of information query to perform.
+ * @param[in,out] slot A ::CCLWrapperInfo* variable, initialized to
+ * `NULL`, which caches the information object between invocations.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return The requested information value. If an error occurs, zero is
+ * returned.
+ * */
+#define ccl_wrapper_get_info_scalar_cached(wrapper1, wrapper2, \
+    param_name, param_type, info_type, slot, err) \
+    *((param_type *) ccl_wrapper_get_info_value_cached( \
+        (CCLWrapper *) (wrapper1), (CCLWrapper *) (wrapper2), \
+        (param_name), sizeof(param_type), (info_type), (slot), (err)))
+
 /* Get information size. */
 CCL_EXPORT
 size_t ccl_wrapper_get_info_size(CCLWrapper * wrapper1,
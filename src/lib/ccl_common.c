@@ -25,6 +25,11 @@
  * @copyright [GNU Lesser General Public License version 3 (LGPLv3)](http://www.gnu.org/licenses/lgpl.html)
  * */
 
+#include <string.h>
+
+/* This file defines the exported symbols, so keep the inline hot-path
+ * aliases from the header out of the way. */
+#define CCL_NO_INLINE_HOT
 #include "ccl_common.h"
 
 /**
@@ -34,29 +39,161 @@
  * */
 CCL_EXPORT
 void ccl_common_version_print(const char * exec_name) {
-    g_printf("%s %s - Compiled with %s C Compiler with support for OpenCL %s\n"
+    /* Everything after the executable name is known at compile time,
+     * so it is baked into a single string literal and written without
+     * format parsing. */
+    fputs(exec_name, stdout);
+    fputs(" " CCL_VERSION_STRING_FINAL " - Compiled with " CCL_COMPILER
+        " C Compiler with support for OpenCL " CCL_OPENCL_VERSION "\n"
         "Copyright (C) 2019 Nuno Fachada\n"
         "License GPLv3+: GNU GPL version 3 or later "
         "<http://gnu.org/licenses/gpl.html>.\n"
         "This is free software: you are free to change and redistribute it.\n"
         "There is NO WARRANTY, to the extent permitted by law.\n\n"
         "Written by Nuno Fachada\n",
-        exec_name, CCL_VERSION_STRING_FINAL, CCL_COMPILER, CCL_OPENCL_VERSION);
+        stdout);
+}
+
+/**
+ * @internal
+ *
+ * @brief Set of string arrays created with ccl_strv_new_arena(), keyed
+ * by the pointer array address. Used by ccl_strv_clear() to release
+ * arena-backed arrays with a single free.
+ */
+static GHashTable * ccl_strv_arenas = NULL;
+
+/* Lock for the arena-backed string array set. */
+G_LOCK_DEFINE_STATIC(ccl_strv_arenas);
+
+/**
+ * Creates a `NULL`-terminated array of strings backed by a single
+ * memory block.
+ *
+ * The pointer array and the string contents are copied into one
+ * allocation, so the whole array is released with a single free by
+ * ::ccl_strv_clear(), instead of one free per string. Useful for large
+ * arrays, e.g. tokenized device extension lists.
+ *
+ * @param[in] src Array of strings to copy.
+ * @param[in] n Number of strings in `src`.
+ * @return A `NULL`-terminated array of strings which should be freed
+ * with ::ccl_strv_clear().
+ * */
+CCL_EXPORT
+char ** ccl_strv_new_arena(const char * const * src, size_t n) {
+
+    /* Make sure src is not NULL. */
+    g_return_val_if_fail(src != NULL, NULL);
+
+    /* Total block size: pointer array plus string contents. */
+    gsize block_size = (n + 1) * sizeof(char *);
+    for (size_t i = 0; i < n; ++i)
+        block_size += strlen(src[i]) + 1;
+
+    /* Allocate one block and pack pointers and strings into it. */
+    char ** strv = g_malloc(block_size);
+    gchar * data = (gchar *) (strv + n + 1);
+    for (size_t i = 0; i < n; ++i) {
+        gsize len = strlen(src[i]) + 1;
+        memcpy(data, src[i], len);
+        strv[i] = data;
+        data += len;
+    }
+    strv[n] = NULL;
+
+    /* Remember this array is arena-backed. */
+    G_LOCK(ccl_strv_arenas);
+    if (ccl_strv_arenas == NULL)
+        ccl_strv_arenas = g_hash_table_new(g_direct_hash, g_direct_equal);
+    g_hash_table_add(ccl_strv_arenas, strv);
+    G_UNLOCK(ccl_strv_arenas);
+
+    /* Return the packed array. */
+    return strv;
 }
 
 /**
  * Frees a `NULL`-terminated array of strings, as well as each string it
  * contains.
  *
+ * Arrays created with ::ccl_strv_new_arena() are released with a single
+ * free; any other array is released with `g_strfreev()` from GLib.
+ *
  * @param[in] str_array A `NULL`-terminated array of strings to free.
 
  * @see @ref ug_deps "The GLib and OpenCL dependencies".
  * */
 CCL_EXPORT
 void ccl_strv_clear(char ** str_array) {
+
+    /* Arena-backed arrays are released with one free. */
+    if (str_array != NULL) {
+        gboolean is_arena = FALSE;
+        G_LOCK(ccl_strv_arenas);
+        if (ccl_strv_arenas != NULL)
+            is_arena = g_hash_table_remove(ccl_strv_arenas, str_array);
+        G_UNLOCK(ccl_strv_arenas);
+        if (is_arena) {
+            g_free(str_array);
+            return;
+        }
+    }
+
+    /* Otherwise free each string and the array itself. */
     g_strfreev(str_array);
 }
 
+/**
+ * Allocate a host memory block aligned for driver zero-copy sharing.
+ *
+ * The returned block is aligned to ::CCL_ZEROCOPY_ALIGN (page size)
+ * and its size is rounded up to a multiple of
+ * ::CCL_ZEROCOPY_SIZE_MULT (cache line size). These are the alignment
+ * rules OpenCL drivers on unified-memory devices (e.g. Intel iGPUs)
+ * require of a host pointer passed with `CL_MEM_USE_HOST_PTR` in order
+ * to use the memory in place instead of silently staging a copy.
+ *
+ * Free the block with ::ccl_aligned_free(), not with `free()`.
+ *
+ * @param[in] size Minimum size of block, in bytes.
+ * @return Pointer to the allocated block, or `NULL` if the allocation
+ * fails.
+ * */
+CCL_EXPORT
+void * ccl_aligned_alloc(size_t size) {
+
+    void * ptr = NULL;
+
+    /* Round size up to the next cache line multiple. */
+    size = (size + CCL_ZEROCOPY_SIZE_MULT - 1)
+        & ~((size_t) (CCL_ZEROCOPY_SIZE_MULT - 1));
+
+#ifdef _WIN32
+    ptr = _aligned_malloc(size, CCL_ZEROCOPY_ALIGN);
+#else
+    if (posix_memalign(&ptr, CCL_ZEROCOPY_ALIGN, size) != 0)
+        ptr = NULL;
+#endif
+
+    return ptr;
+}
+
+/**
+ * Free a host memory block allocated with ::ccl_aligned_alloc().
+ *
+ * @param[in] ptr Pointer to block to free. If `NULL`, does nothing.
+ * */
+CCL_EXPORT
+void ccl_aligned_free(void * ptr) {
+
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
 /**
  * Releases a ::CCLErr object and set it to `NULL`.
  *
@@ -82,7 +219,12 @@ void ccl_err_clear(CCLErr ** err) {
  */
 CCL_EXPORT
 GQuark ccl_error_quark() {
-    return g_quark_from_static_string("ccl-error-quark");
+    static gsize quark = 0;
+    if (g_once_init_enter(&quark)) {
+        GQuark q = g_quark_from_static_string("ccl-error-quark");
+        g_once_init_leave(&quark, (gsize) q);
+    }
+    return (GQuark) quark;
 }
 
 /**
@@ -94,5 +236,26 @@ GQuark ccl_error_quark() {
  */
 CCL_EXPORT
 GQuark ccl_ocl_error_quark() {
-    return g_quark_from_static_string("ccl-ocl-error-quark");
+    static gsize quark = 0;
+    if (g_once_init_enter(&quark)) {
+        GQuark q = g_quark_from_static_string("ccl-ocl-error-quark");
+        g_once_init_leave(&quark, (gsize) q);
+    }
+    return (GQuark) quark;
+}
+
+#ifdef __GNUC__
+/**
+ * @internal
+ *
+ * @brief Warm the error quark caches when the library is loaded, so
+ * even the first error-propagation path finds them initialized and
+ * never touches GLib's quark table lock at run time. Compilers without
+ * constructor support simply initialize the quarks on first use.
+ */
+__attribute__((constructor))
+static void ccl_common_init_quarks(void) {
+    ccl_error_quark();
+    ccl_ocl_error_quark();
 }
+#endif
@@ -333,16 +333,77 @@ typedef enum ccl_error_code {
 CCL_EXPORT
 void ccl_common_version_print(const char * exec_name);
 
+/* Creates a `NULL`-terminated array of strings backed by a single
+ * memory block. */
+CCL_EXPORT
+char ** ccl_strv_new_arena(const char * const * src, size_t n);
+
 /* Frees a `NULL`-terminated array of strings, as well as each string it
  * contains. */
 CCL_EXPORT
 void ccl_strv_clear(char ** str_array);
 
+/**
+ * Alignment, in bytes, required of host pointers for driver zero-copy
+ * sharing (page alignment).
+ * */
+#define CCL_ZEROCOPY_ALIGN 4096
+
+/**
+ * Size multiple, in bytes, required of host buffers for driver
+ * zero-copy sharing (cache line size).
+ * */
+#define CCL_ZEROCOPY_SIZE_MULT 64
+
+/**
+ * Check if a host pointer and buffer size meet the alignment rules for
+ * driver zero-copy sharing, i.e. if the pointer is page-aligned and
+ * the size is a multiple of the cache line size. Buffers allocated
+ * with ::ccl_aligned_alloc() always qualify.
+ *
+ * @param[in] host_ptr Host pointer to check.
+ * @param[in] size Buffer size in bytes to check.
+ * @return `CL_TRUE` if pointer and size qualify for zero-copy,
+ * `CL_FALSE` otherwise.
+ * */
+#define ccl_host_ptr_is_pinned(host_ptr, size) \
+    (((((guintptr) (host_ptr)) % CCL_ZEROCOPY_ALIGN == 0) \
+        && ((size) % CCL_ZEROCOPY_SIZE_MULT == 0)) ? CL_TRUE : CL_FALSE)
+
+/* Allocate a host memory block aligned for driver zero-copy
+ * sharing. */
+CCL_EXPORT
+void * ccl_aligned_alloc(size_t size);
+
+/* Free a host memory block allocated with ccl_aligned_alloc(). */
+CCL_EXPORT
+void ccl_aligned_free(void * ptr);
+
 /* If `err` or `*err` is `NULL`, does nothing. Otherwise, releases memory
  * occupied by `*err` and sets `*err` to `NULL`. */
 CCL_EXPORT
 void ccl_err_clear(CCLErr ** err);
 
+#ifndef CCL_NO_INLINE_HOT
+/**
+ * @internal
+ *
+ * @brief Inline implementation of ccl_err_clear(), used on hot paths so
+ * calls do not go through the shared library PLT. The exported symbol
+ * is kept for ABI compatibility; define `CCL_NO_INLINE_HOT` before
+ * including this header to always call the exported symbol.
+ * */
+static inline void ccl_err_clear_inline(CCLErr ** err) {
+    /* Test for an actual error inline, so the common no-error case
+     * costs two loads and no function call. */
+    if ((err != NULL) && (*err != NULL)) {
+        g_error_free(*err);
+        *err = NULL;
+    }
+}
+#define ccl_err_clear ccl_err_clear_inline
+#endif
+
 /* Resolves to error category identifying string, in this case an error in
  * _cf4ocl_. */
 CCL_EXPORT
@@ -48,6 +48,13 @@ struct ccl_context {
      * */
     CCLPlatform * platf;
 
+    /**
+     * Platform OpenCL version, cached on first query (0 means not yet
+     * determined).
+     * @private
+     * */
+    gint ocl_ver;
+
 };
 
 /**
@@ -502,7 +509,12 @@ cl_uint ccl_context_get_opencl_version(CCLContext * ctx, CCLErr ** err) {
 
     CCLPlatform * platf = NULL;
     CCLErr * err_internal = NULL;
-    cl_uint ver = 0;
+    cl_uint ver;
+
+    /* The platform version is immutable for a given context, so return
+     * the cached value if it was already determined. */
+    ver = (cl_uint) g_atomic_int_get(&ctx->ocl_ver);
+    if (ver != 0) return ver;
 
     platf = ccl_context_get_platform(ctx, &err_internal);
     ccl_if_err_propagate_goto(err, err_internal, error_handler);
@@ -510,6 +522,9 @@ cl_uint ccl_context_get_opencl_version(CCLContext * ctx, CCLErr ** err) {
     ver = ccl_platform_get_opencl_version(platf, &err_internal);
     ccl_if_err_propagate_goto(err, err_internal, error_handler);
 
+    /* Cache the determined version for subsequent calls. */
+    g_atomic_int_set(&ctx->ocl_ver, (gint) ver);
+
     /* If we got here, everything is OK. */
     g_assert(err == NULL || *err == NULL);
     goto finish;
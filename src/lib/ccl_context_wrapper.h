@@ -441,6 +441,12 @@ CCLDevice * const * ccl_context_get_all_devices(CCLContext * ctx,
 /**
  * Alias to ccl_context_destroy().
  *
+ * The alias is resolved by the preprocessor, so it adds no runtime
+ * indirection: a non-final release is a single atomic decrement inside
+ * ccl_wrapper_unref(). Splitting out an inline "peek then decrement"
+ * fast path would race against a concurrent final release, so the
+ * decrement-and-test is deliberately kept in one atomic operation.
+ *
  * @relates ccl_context
  *
  * @param[in] ctx Context wrapper object to destroy if reference count
@@ -1187,6 +1187,35 @@ const CCLDevQueryMap ccl_devquery_info_map[] = {
     {NULL, 0, NULL, NULL, NULL}
 };
 
+/**
+ * @internal
+ *
+ * @brief Table mapping the CPU, GPU, accelerator and custom
+ * `cl_device_type` bits to device type strings, indexed by
+ * `(type >> 1) & 0xF`. Entries follow the same precedence as the
+ * previous conditional chain: CPU, then GPU, then accelerator, then
+ * custom.
+ */
+CCL_EXPORT
+const char * const ccl_devquery_type2str_map[16] = {
+    "Unknown",     /* ---- */
+    "CPU",         /* ---C */
+    "GPU",         /* --G- */
+    "CPU",         /* --GC */
+    "Accelerator", /* -A-- */
+    "CPU",         /* -A-C */
+    "GPU",         /* -AG- */
+    "CPU",         /* -AGC */
+    "Custom",      /* X--- */
+    "CPU",         /* X--C */
+    "GPU",         /* X-G- */
+    "CPU",         /* X-GC */
+    "Accelerator", /* XA-- */
+    "CPU",         /* XA-C */
+    "GPU",         /* XAG- */
+    "CPU"          /* XAGC */
+};
+
 /**
  * @internal
  *
@@ -1196,6 +1225,119 @@ CCL_EXPORT
 const int ccl_devquery_info_map_size =
     sizeof(ccl_devquery_info_map) / sizeof(CCLDevQueryMap) - 1;
 
+/**
+ * @internal
+ *
+ * @brief Hash table mapping parameter name strings to their index in
+ * ::ccl_devquery_info_map, lazily built on first lookup. Replaces a
+ * per-call binary search (several string comparisons) with a single
+ * hash plus one string comparison.
+ */
+static GHashTable * ccl_devquery_index_table = NULL;
+
+/**
+ * @internal
+ *
+ * @brief Hash table mapping `cl_device_info` values to their index in
+ * ::ccl_devquery_info_map, built together with the name index. Lets
+ * code which already holds the enum skip string handling entirely.
+ */
+static GHashTable * ccl_devquery_enum_table = NULL;
+
+/**
+ * @internal
+ *
+ * @brief Dense array with the parameter name of each entry in
+ * ::ccl_devquery_info_map, built together with the index hash table.
+ * Name scans walk this array instead of striding through the
+ * five-field map entries, so each cache line carries names only.
+ *
+ * The pointed-to strings live in a single contiguous pool (see
+ * ccl_devquery_init_lookup()), so successive names are laid out
+ * back-to-back in memory and scans access them with unit stride.
+ */
+static const char ** ccl_devquery_param_names = NULL;
+
+/* Lock for lazy one-time initialization of the parameter name index. */
+G_LOCK_DEFINE_STATIC(ccl_devquery_index_table);
+
+/**
+ * @internal
+ *
+ * @brief Front cache with the handful of parameters real workloads
+ * query most often. These are checked with direct string comparisons
+ * before the general hash lookup.
+ */
+static const char * const ccl_devquery_hot_names[] =
+    { "NAME", "VENDOR", "TYPE", "MAX_COMPUTE_UNITS", "GLOBAL_MEM_SIZE" };
+
+/**
+ * @internal
+ *
+ * @brief Map indexes of the front cache entries, resolved when the
+ * lookup structures are built.
+ */
+static gint ccl_devquery_hot_idxs[G_N_ELEMENTS(ccl_devquery_hot_names)];
+
+/**
+ * @internal
+ *
+ * @brief Build the parameter name lookup structures on first use: the
+ * name to index hash table and the dense parameter name array.
+ */
+static void ccl_devquery_init_lookup() {
+
+    if (g_atomic_pointer_get(&ccl_devquery_index_table) != NULL)
+        return;
+
+    G_LOCK(ccl_devquery_index_table);
+    if (ccl_devquery_index_table == NULL) {
+        GHashTable * table = g_hash_table_new(g_str_hash, g_str_equal);
+        GHashTable * enum_table =
+            g_hash_table_new(g_direct_hash, g_direct_equal);
+        const char ** names =
+            g_new(const char *, ccl_devquery_info_map_size);
+        gchar * pool;
+        gsize pool_size = 0, offset = 0;
+
+        /* Copy parameter names into one contiguous pool, so scans walk
+         * a compact stretch of memory instead of chasing pointers into
+         * scattered string literal sections. */
+        for (gint i = 0; i < ccl_devquery_info_map_size; ++i)
+            pool_size += strlen(ccl_devquery_info_map[i].param_name) + 1;
+        pool = g_malloc(pool_size);
+
+        for (gint i = 0; i < ccl_devquery_info_map_size; ++i) {
+            gsize len = strlen(ccl_devquery_info_map[i].param_name) + 1;
+            memcpy(pool + offset, ccl_devquery_info_map[i].param_name, len);
+            names[i] = pool + offset;
+            offset += len;
+            /* Indexes are kept 1-based so that index 0 is
+             * distinguishable from a failed lookup. */
+            g_hash_table_insert(table,
+                (gpointer) names[i], GINT_TO_POINTER(i + 1));
+
+            /* Also index by cl_device_info value; if several entries
+             * share a value, the first one is kept. */
+            if (!g_hash_table_contains(enum_table, GUINT_TO_POINTER(
+                    (guint) ccl_devquery_info_map[i].device_info)))
+                g_hash_table_insert(enum_table, GUINT_TO_POINTER(
+                    (guint) ccl_devquery_info_map[i].device_info),
+                    GINT_TO_POINTER(i + 1));
+        }
+        ccl_devquery_param_names = names;
+        ccl_devquery_enum_table = enum_table;
+
+        /* Resolve the map indexes of the front cache entries. */
+        for (guint i = 0; i < G_N_ELEMENTS(ccl_devquery_hot_names); ++i)
+            ccl_devquery_hot_idxs[i] = GPOINTER_TO_INT(g_hash_table_lookup(
+                table, ccl_devquery_hot_names[i])) - 1;
+
+        g_atomic_pointer_set(&ccl_devquery_index_table, table);
+    }
+    G_UNLOCK(ccl_devquery_index_table);
+}
+
 /**
  * @addtogroup CCL_DEVICE_QUERY
  * @{
@@ -1218,35 +1360,55 @@ int ccl_devquery_get_index(const char * name) {
     /* Make sure name is not NULL. */
     g_return_val_if_fail(name != NULL, -1);
 
-    /* Search indexes. */
-    gint idx_middle;
-    guint idx_start, idx_end;
+    /* Looked-up value, NULL if not found. */
+    gpointer val;
 
-    /* String comparison result. */
-    gint cmp_res;
+    /* Build the name lookup structures on first use. */
+    ccl_devquery_init_lookup();
 
-    /* Found info flag. */
-    gboolean found = FALSE;
+    /* Check the front cache of frequently queried parameters first,
+     * skipping the hash in the common case. */
+    for (guint i = 0; i < G_N_ELEMENTS(ccl_devquery_hot_names); ++i)
+        if (strcmp(name, ccl_devquery_hot_names[i]) == 0)
+            return ccl_devquery_hot_idxs[i];
 
-    /* Binary search. */
-    idx_start = 0;
-    idx_end = ccl_devquery_info_map_size - 1;
-    while (idx_end >= idx_start) {
-        idx_middle = (idx_start + idx_end) / 2;
-        cmp_res = g_strcmp0(
-            name, ccl_devquery_info_map[idx_middle].param_name);
-        if (cmp_res == 0) {
-            found = TRUE;
-            break;
-        }
-        if (cmp_res > 0)
-            idx_start = idx_middle + 1;
-        else
-            idx_end = idx_middle - 1;
-    }
+    /* Perform lookup: one hash plus one string comparison. */
+    val = g_hash_table_lookup(ccl_devquery_index_table, name);
 
     /* Return result */
-    return found ? idx_middle : -1;
+    return GPOINTER_TO_INT(val) - 1;
+}
+
+/**
+ * @brief Return the device information map object associated with the
+ * given `cl_device_info` value, without any string handling.
+ *
+ * If several map entries share the same `cl_device_info` value, the
+ * first one is returned.
+ *
+ * @public @memberof ccl_devquery_map
+ *
+ * @param[in] info A `cl_device_info` value.
+ * @return The respective ::CCLDevQueryMap*, or `NULL` if the given
+ * value is not present in ::ccl_devquery_info_map.
+ * */
+CCL_EXPORT
+const CCLDevQueryMap * ccl_devquery_by_enum(cl_device_info info) {
+
+    /* Looked-up value, NULL if not found. */
+    gpointer val;
+
+    /* Build the name lookup structures on first use. */
+    ccl_devquery_init_lookup();
+
+    /* Perform direct lookup by cl_device_info value. */
+    val = g_hash_table_lookup(
+        ccl_devquery_enum_table, GUINT_TO_POINTER((guint) info));
+
+    /* Return the respective map entry, or NULL if not found. */
+    return (val != NULL)
+        ? &ccl_devquery_info_map[GPOINTER_TO_INT(val) - 1]
+        : NULL;
 }
 
 /**
@@ -1269,31 +1431,22 @@ gchar * ccl_devquery_get_prefix_final(const char * prefix) {
     /* Make sure prefix is not NULL. */
     g_return_val_if_fail(prefix != NULL, NULL);
 
-    /* Auxiliary string variables. */
-    gchar * str_upper;
-    gchar * str_aux;
-    gchar * str_final;
+    /* Number of characters to skip from the start of the prefix. */
+    gsize skip;
 
-    /* Make string uppercase. */
-    str_upper = g_ascii_strup(prefix, -1);
-
-    /* Remove possible cl_device or cl_ prefix */
-    if (g_str_has_prefix(str_upper, "CL_DEVICE_")) {
-        str_aux = str_upper + strlen("CL_DEVICE_");
-    } else if (g_str_has_prefix(str_upper, "CL_")) {
-        str_aux = str_upper + strlen("CL_");
+    /* Find a possible cl_device_ or cl_ prefix, case-insensitively, so
+     * only the remainder needs to be uppercased and copied. */
+    if (g_ascii_strncasecmp(prefix, "CL_DEVICE_",
+            strlen("CL_DEVICE_")) == 0) {
+        skip = strlen("CL_DEVICE_");
+    } else if (g_ascii_strncasecmp(prefix, "CL_", strlen("CL_")) == 0) {
+        skip = strlen("CL_");
     } else {
-        str_aux = str_upper;
+        skip = 0;
     }
 
-    /* Create a new string for returning. */
-    str_final = g_strdup(str_aux);
-
-    /* Free lowercase string. */
-    g_free(str_upper);
-
-    /* Return result */
-    return str_final;
+    /* Uppercase the remainder in a single allocation and pass. */
+    return g_ascii_strup(prefix + skip, -1);
 }
 
 /**
@@ -1341,6 +1494,11 @@ cl_device_info ccl_devquery_name(const char * name) {
  * @brief Search for a device information parameter by matching part
  * of its name. This function is supposed to be used in a loop.
  *
+ * Matching is case-insensitive. Since parameter names in
+ * ::ccl_devquery_info_map are all uppercase, the given substring is
+ * uppercased once per call, so no per-character case folding takes
+ * place in the inner search loop.
+ *
  * @public @memberof ccl_devquery_map
  *
  * @param[in] substr String to match with parameter name.
@@ -1363,16 +1521,24 @@ const CCLDevQueryMap * ccl_devquery_match(const char * substr, int * idx) {
     /* Found result. */
     const CCLDevQueryMap * info_row = NULL;
 
-    /* Linear search. */
+    /* Uppercased copy of substr, hoisted out of the search loop. */
+    gchar * substr_upper = g_ascii_strup(substr, -1);
+
+    /* Build the name lookup structures on first use. */
+    ccl_devquery_init_lookup();
+
+    /* Linear search over the dense parameter name array. */
     for ( ; *idx < ccl_devquery_info_map_size; (*idx)++) {
-        if (g_strstr_len(
-            ccl_devquery_info_map[*idx].param_name, -1, substr)) {
+        if (strstr(ccl_devquery_param_names[*idx], substr_upper)) {
 
             found = TRUE;
             break;
         }
     }
 
+    /* Free the uppercased copy of substr. */
+    g_free(substr_upper);
+
     /* Set found result. */
     if (found)
         info_row = &ccl_devquery_info_map[*idx];
@@ -1384,4 +1550,74 @@ const CCLDevQueryMap * ccl_devquery_match(const char * substr, int * idx) {
     return info_row;
 }
 
+/**
+ * @brief Query all known device information parameters of a device,
+ * invoking a callback for each supported one.
+ *
+ * Unlike per-parameter queries through ::ccl_device_get_info(), which
+ * allocate and cache a wrapper object for each parameter, this function
+ * reuses a single output buffer for the whole map, growing it only
+ * when a parameter value does not fit. Parameters not supported by the
+ * device or its OpenCL implementation are skipped.
+ *
+ * @public @memberof ccl_devquery_map
+ *
+ * @param[in] dev A device wrapper object.
+ * @param[in] cb Callback invoked for each successfully queried
+ * parameter.
+ * @param[in] user_data User data passed to the callback.
+ * */
+CCL_EXPORT
+void ccl_devquery_bulk(
+    CCLDevice * dev, ccl_devquery_bulk_cb cb, void * user_data) {
+
+    /* Make sure dev is not NULL. */
+    g_return_if_fail(dev != NULL);
+
+    /* Make sure cb is not NULL. */
+    g_return_if_fail(cb != NULL);
+
+    /* The wrapped OpenCL device. */
+    cl_device_id device = ccl_device_unwrap(dev);
+
+    /* Shared output buffer, grown on demand. */
+    gsize capacity = 4096;
+    gpointer buf = g_malloc(capacity);
+
+    /* Size of current parameter value. */
+    size_t size;
+
+    /* OpenCL status code. */
+    cl_int ocl_status;
+
+    /* Cycle through all parameters in the device information map. */
+    for (gint i = 0; i < ccl_devquery_info_map_size; ++i) {
+
+        ocl_status = clGetDeviceInfo(device,
+            ccl_devquery_info_map[i].device_info, capacity, buf, &size);
+
+        /* CL_INVALID_VALUE may mean the buffer is too small; determine
+         * the required size, grow the buffer and retry. */
+        if (ocl_status == CL_INVALID_VALUE) {
+            ocl_status = clGetDeviceInfo(device,
+                ccl_devquery_info_map[i].device_info, 0, NULL, &size);
+            if ((ocl_status == CL_SUCCESS) && (size > capacity)) {
+                capacity = size;
+                buf = g_realloc(buf, capacity);
+                ocl_status = clGetDeviceInfo(device,
+                    ccl_devquery_info_map[i].device_info,
+                    capacity, buf, &size);
+            }
+        }
+
+        /* Report the parameter if it was successfully queried;
+         * unsupported parameters are skipped. */
+        if (ocl_status == CL_SUCCESS)
+            cb(&ccl_devquery_info_map[i], buf, size, user_data);
+    }
+
+    /* Release the shared output buffer. */
+    g_free(buf);
+}
+
 /** @} */
@@ -59,6 +59,13 @@ typedef char * (*ccl_devquery_format)(CCLWrapperInfo * info, char * out,
 
 /**
  * Maps a string to a `cl_device_info` bitfield.
+ *
+ * @note This layout is part of the public API and cannot change without
+ * breaking the ABI. Hot name lookups and scans therefore do not walk
+ * this array-of-structs directly; they use compact internal structures
+ * (a name-to-index hash table and a contiguous name pool) built on
+ * first use, and only dereference entries of this array by index once
+ * a match is found.
  * */
 typedef struct ccl_devquery_map {
 
@@ -118,24 +125,54 @@ gchar * ccl_devquery_get_prefix_final(const char * prefix);
 CCL_EXPORT
 cl_device_info ccl_devquery_name(const char * name);
 
+/* Return the device information map object associated with the given
+ * `cl_device_info` value, without any string handling. */
+CCL_EXPORT
+const CCLDevQueryMap * ccl_devquery_by_enum(cl_device_info info);
+
 /* Search for a device information parameter by matching part
  * of its name. This function is supposed to be used in a loop. */
 CCL_EXPORT
 const CCLDevQueryMap * ccl_devquery_match(const char * substr, int * idx);
 
+/**
+ * Callback invoked by ::ccl_devquery_bulk() for each device parameter
+ * successfully queried.
+ *
+ * @param[in] info_row Map entry describing the queried parameter.
+ * @param[in] value Parameter value. Only valid during the callback; the
+ * underlying buffer is reused for the next parameter.
+ * @param[in] size Size of parameter value in bytes.
+ * @param[in] user_data User data passed to ::ccl_devquery_bulk().
+ * */
+typedef void (*ccl_devquery_bulk_cb)(const CCLDevQueryMap * info_row,
+    void * value, size_t size, void * user_data);
+
+/* Query all known device information parameters of a device, invoking
+ * a callback for each supported one. */
+CCL_EXPORT
+void ccl_devquery_bulk(
+    CCLDevice * dev, ccl_devquery_bulk_cb cb, void * user_data);
+
+/** Table mapping the CPU, GPU, accelerator and custom `cl_device_type`
+ * bits to device type strings. Used by the ccl_devquery_type2str()
+ * macro; not meant to be accessed directly. */
+CCL_EXPORT
+extern const char * const ccl_devquery_type2str_map[16];
+
 /**
  * Map an OpenCL `cl_device_type` object to a string identifying
  * the device type.
  *
+ * The CPU, GPU, accelerator and custom device type bits index a
+ * 16-entry string table directly, avoiding a chain of conditional
+ * tests on each bit.
+ *
  * @param[in] type The OpenCL `cl_device_type`.
  * @return String identifying device type.
  * */
 #define ccl_devquery_type2str(type) \
-    (((type) & CL_DEVICE_TYPE_CPU) ? "CPU" : \
-        (((type) & CL_DEVICE_TYPE_GPU) ? "GPU" : \
-            (((type) & CL_DEVICE_TYPE_ACCELERATOR) ? "Accelerator" : \
-                (((type) & CL_DEVICE_TYPE_CUSTOM) ? "Custom" : \
-                    "Unknown"))))
+    (ccl_devquery_type2str_map[((type) >> 1) & 0xF])
 
 /** @} */
 
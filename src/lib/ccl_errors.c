@@ -26,6 +26,7 @@
  * */
 
 #include "ccl_errors.h"
+#include "_ccl_defs.h"
 
 static const char * ccl_errors[] = {
     "Successful operation", /* CL_SUCCESS - 0 */
@@ -116,7 +117,7 @@ static const int ccl_errors_count = sizeof(ccl_errors) / sizeof(char *);
  * @param[in] code OpenCL error code.
  * @return A readable string.
  * */
-CCL_EXPORT
+CCL_EXPORT CCL_COLD
 const char * ccl_err(int code) {
     int index = -1 * code;
     return (index >= 0) && (index < ccl_errors_count)
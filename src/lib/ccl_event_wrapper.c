@@ -51,6 +51,112 @@ struct ccl_event {
 
 };
 
+/**
+ * @internal
+ * @brief Depth of the per-thread pool of recycled event wait list
+ * arrays.
+ * */
+#define CCL_EWL_POOL_SIZE 4
+
+/**
+ * @internal
+ * @brief Per-thread pool of event wait list arrays recycled by
+ * ccl_event_wait_list_clear() and reused by
+ * ccl_event_wait_list_add()/_add_v().
+ *
+ * Wait lists are typically built and cleared once per enqueue, so
+ * without the pool each enqueue in the hot path pays an array
+ * allocation and deallocation. Recycled arrays keep their capacity, so
+ * the steady add/enqueue/clear cycle performs no allocations at all.
+ * The pool is thread-local, so no locking is required.
+ * */
+struct ccl_ewl_pool {
+
+    /** Recycled arrays. @private */
+    GPtrArray * arrs[CCL_EWL_POOL_SIZE];
+
+    /** Number of recycled arrays in the pool. @private */
+    guint num_arrs;
+};
+
+/* Forward declaration of the pool destructor, required by
+ * G_PRIVATE_INIT. */
+static void ccl_ewl_pool_destroy(gpointer data);
+
+/**
+ * @internal
+ * @brief Key for the per-thread event wait list array pool.
+ * */
+static GPrivate ccl_ewl_pool_private =
+    G_PRIVATE_INIT(ccl_ewl_pool_destroy);
+
+/**
+ * @internal
+ *
+ * @brief Free a thread's event wait list array pool. Called
+ * automatically when the owning thread terminates.
+ *
+ * @param[in] data The pool to destroy.
+ * */
+static void ccl_ewl_pool_destroy(gpointer data) {
+
+    struct ccl_ewl_pool * pool = (struct ccl_ewl_pool *) data;
+
+    for (guint i = 0; i < pool->num_arrs; ++i)
+        g_ptr_array_free(pool->arrs[i], TRUE);
+    g_slice_free(struct ccl_ewl_pool, pool);
+}
+
+/**
+ * @internal
+ *
+ * @brief Get an empty event wait list array, reusing one from the
+ * current thread's pool if available.
+ *
+ * @return An empty array of `cl_event` objects.
+ * */
+static GPtrArray * ccl_ewl_acquire(void) {
+
+    struct ccl_ewl_pool * pool = g_private_get(&ccl_ewl_pool_private);
+
+    /* Reuse a pooled array if the pool exists and is not empty. Pooled
+     * arrays are empty, but keep the capacity they had when
+     * recycled. */
+    if ((pool != NULL) && (pool->num_arrs > 0))
+        return pool->arrs[--pool->num_arrs];
+
+    /* Otherwise allocate a fresh array. */
+    return g_ptr_array_new();
+}
+
+/**
+ * @internal
+ *
+ * @brief Recycle an event wait list array into the current thread's
+ * pool, or free it if the pool is full.
+ *
+ * @param[in] arr Array to recycle.
+ * */
+static void ccl_ewl_release(GPtrArray * arr) {
+
+    struct ccl_ewl_pool * pool = g_private_get(&ccl_ewl_pool_private);
+
+    /* Create the pool on first use. */
+    if (pool == NULL) {
+        pool = g_slice_new0(struct ccl_ewl_pool);
+        g_private_set(&ccl_ewl_pool_private, pool);
+    }
+
+    if (pool->num_arrs < CCL_EWL_POOL_SIZE) {
+        /* Empty the array, keeping its capacity, and pool it. */
+        g_ptr_array_set_size(arr, 0);
+        pool->arrs[pool->num_arrs++] = arr;
+    } else {
+        /* Pool is full, free the array. */
+        g_ptr_array_free(arr, TRUE);
+    }
+}
+
 /**
  * @addtogroup CCL_EVENT_WRAPPER
  * @{
@@ -719,7 +825,7 @@ CCLEventWaitList * ccl_event_wait_list_add(
 
     /* Initialize list if required. */
     if (*evt_wait_lst == NULL)
-        *evt_wait_lst = g_ptr_array_new();
+        *evt_wait_lst = ccl_ewl_acquire();
 
     /* Initialize variable argument list. */
     va_start(al, evt_wait_lst);
@@ -764,7 +870,7 @@ CCLEventWaitList * ccl_event_wait_list_add_v(
 
     /* Initialize list if required. */
     if (*evt_wait_lst == NULL)
-        *evt_wait_lst = g_ptr_array_new();
+        *evt_wait_lst = ccl_ewl_acquire();
 
     /* Cycle through array of event wrapper objects. */
     for (guint i = 0; evts[i] != NULL; ++i) {
@@ -791,7 +897,7 @@ CCL_EXPORT
 void ccl_event_wait_list_clear(CCLEventWaitList * evt_wait_lst) {
 
     if ((evt_wait_lst != NULL) && (*evt_wait_lst != NULL)) {
-        g_ptr_array_free(*evt_wait_lst, TRUE);
+        ccl_ewl_release(*evt_wait_lst);
         *evt_wait_lst = NULL;
     }
 }
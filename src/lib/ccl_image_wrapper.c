@@ -25,6 +25,7 @@
  * @copyright [GNU Lesser General Public License version 3 (LGPLv3)](http://www.gnu.org/licenses/lgpl.html)
  * */
 
+#include <string.h>
 #include "ccl_image_wrapper.h"
 #include "ccl_buffer_wrapper.h"
 #include "_ccl_memobj_wrapper.h"
@@ -42,13 +43,220 @@ struct ccl_image {
      * @private
      * */
     CCLMemObj mo;
+
+    /**
+     * Image description given at creation time, kept so later
+     * operations can consult the image type and dimensions without a
+     * clGetImageInfo round trip. Only meaningful if `desc_cached` is
+     * `CL_TRUE`; images wrapped from pre-existing OpenCL objects do
+     * not have it.
+     * @private
+     * */
+    CCLImageDesc desc;
+
+    /**
+     * Is the `desc` field valid?
+     * @private
+     * */
+    cl_bool desc_cached;
+
+    /**
+     * Memory flags given at creation time, kept so transfer functions
+     * can check for CL_MEM_ALLOC_HOST_PTR without a clGetMemObjectInfo
+     * round trip. Only meaningful if `flags_cached` is `CL_TRUE`;
+     * images wrapped from pre-existing OpenCL objects do not have it.
+     * @private
+     * */
+    cl_mem_flags flags;
+
+    /**
+     * Is the `flags` field valid?
+     * @private
+     * */
+    cl_bool flags_cached;
+
+    /**
+     * Pinned host staging block used by
+     * ::ccl_image_enqueue_copy_cross_device(), kept so repeated copies
+     * of the same image reuse one allocation. `NULL` until first use.
+     * @private
+     * */
+    void * staging;
+
+    /**
+     * Size in bytes of the `staging` block.
+     * @private
+     * */
+    size_t staging_size;
+};
+
+/**
+ * @internal
+ *
+ * @brief Implementation of ccl_wrapper_release_fields() function for
+ * ::CCLImage wrapper objects.
+ *
+ * @private @memberof ccl_image
+ *
+ * @param[in] img An image wrapper object.
+ * */
+static void ccl_image_release_fields(CCLImage * img) {
+
+    /* Make sure img wrapper object is not NULL. */
+    g_return_if_fail(img != NULL);
+
+    /* Release the staging block, if any. */
+    if (img->staging != NULL)
+        ccl_aligned_free(img->staging);
+}
+
+/**
+ * @internal
+ *
+ * @brief Kinds of values accepted by the ccl_image_new() key-value
+ * list. The kind determines how the value is fetched from the variable
+ * argument list.
+ */
+enum ccl_image_key_kind {
+    CCL_IMAGE_KEY_UINT,
+    CCL_IMAGE_KEY_SIZET,
+    CCL_IMAGE_KEY_MEMOBJ
+};
+
+/**
+ * @internal
+ *
+ * @brief Table of keys accepted by ccl_image_new(), with the offset and
+ * value kind of the respective ::CCLImageDesc field.
+ */
+static const struct ccl_image_key {
+    const char * name;
+    guint16 offset;
+    guint8 kind;
+} ccl_image_keys[] = {
+    { "image_type",
+        G_STRUCT_OFFSET(CCLImageDesc, image_type), CCL_IMAGE_KEY_UINT },
+    { "image_width",
+        G_STRUCT_OFFSET(CCLImageDesc, image_width), CCL_IMAGE_KEY_SIZET },
+    { "image_height",
+        G_STRUCT_OFFSET(CCLImageDesc, image_height), CCL_IMAGE_KEY_SIZET },
+    { "image_depth",
+        G_STRUCT_OFFSET(CCLImageDesc, image_depth), CCL_IMAGE_KEY_SIZET },
+    { "image_array_size",
+        G_STRUCT_OFFSET(CCLImageDesc, image_array_size),
+        CCL_IMAGE_KEY_SIZET },
+    { "image_row_pitch",
+        G_STRUCT_OFFSET(CCLImageDesc, image_row_pitch),
+        CCL_IMAGE_KEY_SIZET },
+    { "image_slice_pitch",
+        G_STRUCT_OFFSET(CCLImageDesc, image_slice_pitch),
+        CCL_IMAGE_KEY_SIZET },
+    { "num_mip_levels",
+        G_STRUCT_OFFSET(CCLImageDesc, num_mip_levels), CCL_IMAGE_KEY_UINT },
+    { "num_samples",
+        G_STRUCT_OFFSET(CCLImageDesc, num_samples), CCL_IMAGE_KEY_UINT },
+    { "memobj",
+        G_STRUCT_OFFSET(CCLImageDesc, memobj), CCL_IMAGE_KEY_MEMOBJ }
 };
 
+/**
+ * @internal
+ *
+ * @brief Return the key table entry for the given ccl_image_new() key,
+ * or `NULL` if the key is unknown. Lookups go through a hash table
+ * built on first use, replacing a string comparison per known key with
+ * a single hash plus one comparison.
+ */
+static const struct ccl_image_key * ccl_image_key_lookup(const char * key) {
+
+    static gsize table_gsize = 0;
+
+    /* Build the key hash table on first use. */
+    if (g_once_init_enter(&table_gsize)) {
+        GHashTable * table = g_hash_table_new(g_str_hash, g_str_equal);
+        for (guint i = 0; i < G_N_ELEMENTS(ccl_image_keys); ++i)
+            g_hash_table_insert(table, (gpointer) ccl_image_keys[i].name,
+                (gpointer) &ccl_image_keys[i]);
+        g_once_init_leave(&table_gsize, (gsize) table);
+    }
+
+    /* Perform lookup. */
+    return g_hash_table_lookup((GHashTable *) table_gsize, key);
+}
+
 /**
  * @addtogroup CCL_IMAGE_WRAPPER
  * @{
  */
 
+/**
+ * @internal
+ *
+ * @brief Type of adapter functions around the deprecated OpenCL
+ * 1.0/1.1 image constructors, all taking the full image description.
+ */
+typedef cl_mem (*ccl_image_deprecated_ctor)(cl_context context,
+    cl_mem_flags flags, const cl_image_format * image_format,
+    const CCLImageDesc * img_dsc, void * host_ptr, cl_int * ocl_status);
+
+/**
+ * @internal
+ *
+ * @brief Adapter around clCreateImage2D() for the deprecated image
+ * constructor table.
+ */
+static cl_mem ccl_image_ctor_2d(cl_context context, cl_mem_flags flags,
+    const cl_image_format * image_format, const CCLImageDesc * img_dsc,
+    void * host_ptr, cl_int * ocl_status) {
+
+    CCL_BEGIN_IGNORE_DEPRECATIONS
+
+    return clCreateImage2D(context, flags, image_format,
+        img_dsc->image_width, img_dsc->image_height,
+        img_dsc->image_row_pitch, host_ptr, ocl_status);
+
+    CCL_END_IGNORE_DEPRECATIONS
+}
+
+/**
+ * @internal
+ *
+ * @brief Adapter around clCreateImage3D() for the deprecated image
+ * constructor table.
+ */
+static cl_mem ccl_image_ctor_3d(cl_context context, cl_mem_flags flags,
+    const cl_image_format * image_format, const CCLImageDesc * img_dsc,
+    void * host_ptr, cl_int * ocl_status) {
+
+    CCL_BEGIN_IGNORE_DEPRECATIONS
+
+    return clCreateImage3D(context, flags, image_format,
+        img_dsc->image_width, img_dsc->image_height,
+        img_dsc->image_depth, img_dsc->image_row_pitch,
+        img_dsc->image_slice_pitch, host_ptr, ocl_status);
+
+    CCL_END_IGNORE_DEPRECATIONS
+}
+
+/**
+ * @internal
+ *
+ * @brief Deprecated image constructors indexed by
+ * `image_type - CL_MEM_OBJECT_IMAGE2D`. The `cl_mem_object_type` image
+ * values are contiguous, so the constructor is picked with one bounds
+ * check and an indirect call instead of a compare chain. `NULL`
+ * entries have no OpenCL 1.0/1.1 constructor.
+ */
+static const ccl_image_deprecated_ctor
+    ccl_image_deprecated_ctors[] = {
+    ccl_image_ctor_2d,  /* CL_MEM_OBJECT_IMAGE2D */
+    ccl_image_ctor_3d,  /* CL_MEM_OBJECT_IMAGE3D */
+    NULL,               /* CL_MEM_OBJECT_IMAGE2D_ARRAY */
+    NULL,               /* CL_MEM_OBJECT_IMAGE1D */
+    NULL,               /* CL_MEM_OBJECT_IMAGE1D_ARRAY */
+    NULL                /* CL_MEM_OBJECT_IMAGE1D_BUFFER */
+};
+
 /**
  * @internal
  *
@@ -80,47 +288,26 @@ static cl_mem ccl_image_new_deprecated(CCLContext * ctx, cl_mem_flags flags,
     cl_mem image = NULL;
     /* OpenCL function status. */
     cl_int ocl_status;
+    /* Index into the deprecated constructor table. */
+    guint type_idx = img_dsc->image_type - CL_MEM_OBJECT_IMAGE2D;
 
-    CCL_BEGIN_IGNORE_DEPRECATIONS
-
-    /* Check what type of image to create. */
-    if (img_dsc->image_type == CL_MEM_OBJECT_IMAGE2D) {
-
-        /* Create a 2D image. */
-        image = clCreateImage2D(ccl_context_unwrap(ctx), flags,
-            image_format, img_dsc->image_width, img_dsc->image_height,
-            img_dsc->image_row_pitch, host_ptr, &ocl_status);
-
-        ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
-            CL_SUCCESS != ocl_status, ocl_status, error_handler,
-            "%s: unable to create image with clCreateImage2D() " \
-            "(OpenCL error %d: %s).",
-            CCL_STRD, ocl_status, ccl_err(ocl_status));
-
-    } else if (img_dsc->image_type == CL_MEM_OBJECT_IMAGE3D) {
-
-        /* Create a 3D image. */
-        image = clCreateImage3D(ccl_context_unwrap(ctx), flags,
-            image_format, img_dsc->image_width, img_dsc->image_height,
-            img_dsc->image_depth, img_dsc->image_row_pitch,
-            img_dsc->image_slice_pitch, host_ptr, &ocl_status);
-
-        ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
-            CL_SUCCESS != ocl_status, ocl_status, error_handler,
-            "%s: unable to create image with clCreateImage3D() " \
-            "(OpenCL error %d: %s).",
-            CCL_STRD, ocl_status, ccl_err(ocl_status));
-
-    } else {
-
-        /* Unknown or unsupported image type. */
-        ccl_if_err_create_goto(*err, CCL_ERROR, CL_TRUE,
-            CCL_ERROR_UNSUPPORTED_OCL, error_handler,
-            "%s: unknown or unsuported image type (%x)", CCL_STRD,
-            img_dsc->image_type);
-    }
+    /* Check that the image type has a deprecated constructor. */
+    ccl_if_err_create_goto(*err, CCL_ERROR,
+        (type_idx >= G_N_ELEMENTS(ccl_image_deprecated_ctors))
+        || (ccl_image_deprecated_ctors[type_idx] == NULL),
+        CCL_ERROR_UNSUPPORTED_OCL, error_handler,
+        "%s: unknown or unsuported image type (%x)", CCL_STRD,
+        img_dsc->image_type);
 
-    CCL_END_IGNORE_DEPRECATIONS
+    /* Create the image with the type's constructor. */
+    image = ccl_image_deprecated_ctors[type_idx](
+        ccl_context_unwrap(ctx), flags, image_format, img_dsc,
+        host_ptr, &ocl_status);
+    ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
+        CL_SUCCESS != ocl_status, ocl_status, error_handler,
+        "%s: unable to create image with the deprecated OpenCL 1.0/1.1 " \
+        "API (OpenCL error %d: %s).",
+        CCL_STRD, ocl_status, ccl_err(ocl_status));
 
     /* If we got here, everything is OK. */
     g_assert(err == NULL || *err == NULL);
@@ -171,7 +358,8 @@ CCLImage * ccl_image_new_wrap(cl_mem mem_object) {
 CCL_EXPORT
 void ccl_image_destroy(CCLImage * img) {
 
-    ccl_wrapper_unref((CCLWrapper *) img, sizeof(CCLImage), NULL,
+    ccl_wrapper_unref((CCLWrapper *) img, sizeof(CCLImage),
+        (ccl_wrapper_release_fields) ccl_image_release_fields,
         (ccl_wrapper_release_cl_object) clReleaseMemObject, NULL);
 }
 
@@ -197,6 +385,13 @@ void ccl_image_destroy(CCLImage * img) {
  * clCreateImage2D() and clCreateImage3D() if the platform's OpenCL
  * version is 1.1 or lower, or the clCreateImage() function otherwise.
  *
+ * @note On unified-memory devices (e.g. Intel iGPUs), passing
+ * `CL_MEM_USE_HOST_PTR` with a `host_ptr` that satisfies
+ * ccl_host_ptr_is_pinned() — e.g. one obtained with
+ * ::ccl_aligned_alloc() — allows the driver to use the host memory in
+ * place (zero-copy). A misaligned pointer silently falls back to a
+ * staged copy.
+ *
  * @public @memberof ccl_image
  *
  * @param[in] ctx A context wrapper object on which the image wrapper
@@ -248,27 +443,24 @@ CCLImage * ccl_image_new_v(CCLContext * ctx, cl_mem_flags flags,
     if (ocl_ver >= 120) {
         /* OpenCL is >= 1.2, use "new" API. */
 
-        /* OpenCL image descriptor. Initialize it with data from
-         * img_dsc (CCLImageDesc), unwrapping the wrapped buffer, if
-         * any. */
-        cl_mem memory_object = (img_dsc->memobj != NULL)
+        /* OpenCL image descriptor. ::CCLImageDesc mirrors the layout
+         * of cl_image_desc field by field (checked below), differing
+         * only in the trailing pointer, which holds a wrapper object
+         * instead of a cl_mem. Copy the descriptor in one go and patch
+         * the trailing field with the unwrapped memory object. */
+        cl_image_desc image_desc;
+
+        G_STATIC_ASSERT(sizeof(cl_image_desc) == sizeof(CCLImageDesc));
+        G_STATIC_ASSERT(G_STRUCT_OFFSET(cl_image_desc, image_type)
+            == G_STRUCT_OFFSET(CCLImageDesc, image_type));
+        G_STATIC_ASSERT(G_STRUCT_OFFSET(cl_image_desc, num_samples)
+            == G_STRUCT_OFFSET(CCLImageDesc, num_samples));
+        G_STATIC_ASSERT(G_STRUCT_OFFSET(cl_image_desc, buffer)
+            == G_STRUCT_OFFSET(CCLImageDesc, memobj));
+
+        memcpy(&image_desc, img_dsc, sizeof(cl_image_desc));
+        image_desc.buffer = (img_dsc->memobj != NULL)
             ? ccl_memobj_unwrap(img_dsc->memobj) : NULL;
-        const cl_image_desc image_desc = {
-            .image_type = img_dsc->image_type,
-            .image_width = img_dsc->image_width,
-            .image_height = img_dsc->image_height,
-            .image_depth = img_dsc->image_depth,
-            .image_array_size = img_dsc->image_array_size,
-            .image_row_pitch = img_dsc->image_row_pitch,
-            .image_slice_pitch = img_dsc->image_slice_pitch,
-            .num_mip_levels = img_dsc->num_mip_levels,
-            .num_samples = img_dsc->num_samples,
-#ifdef CL_VERSION_2_0
-            .mem_object = memory_object
-#else
-            .buffer = memory_object
-#endif
-        };
 
         /* Create image. */
         image = clCreateImage(ccl_context_unwrap(ctx), flags,
@@ -298,6 +490,14 @@ CCLImage * ccl_image_new_v(CCLContext * ctx, cl_mem_flags flags,
     /* Wrap image. */
     img = ccl_image_new_wrap(image);
 
+    /* Cache the image description and memory flags in the wrapper, so
+     * image operations can consult type, dimensions and allocation
+     * flags without querying OpenCL. */
+    img->desc = *img_dsc;
+    img->desc_cached = CL_TRUE;
+    img->flags = flags;
+    img->flags_cached = CL_TRUE;
+
     /* If we got here, everything is OK. */
     g_assert(err == NULL || *err == NULL);
     goto finish;
@@ -397,35 +597,35 @@ CCLImage * ccl_image_new(CCLContext * ctx, cl_mem_flags flags,
     va_start(args_va, err);
 
     /* Check if any arguments are given, and if so, populate
-     * image_dsc. */
+     * image_dsc. Each key is resolved with a single hash lookup
+     * instead of a chain of string comparisons. */
     while ((key = va_arg(args_va, const char *)) != NULL) {
 
-        if (g_strcmp0(key, "image_type") == 0) {
-            image_dsc.image_type = va_arg(args_va, cl_mem_object_type);
-        } else if (g_strcmp0(key, "image_width") == 0) {
-            image_dsc.image_width = va_arg(args_va, size_t);
-        } else if (g_strcmp0(key, "image_height") == 0) {
-            image_dsc.image_height = va_arg(args_va, size_t);
-        } else if (g_strcmp0(key, "image_depth") == 0) {
-            image_dsc.image_depth = va_arg(args_va, size_t);
-        } else if (g_strcmp0(key, "image_array_size") == 0) {
-            image_dsc.image_array_size = va_arg(args_va, size_t);
-        } else if (g_strcmp0(key, "image_row_pitch") == 0) {
-            image_dsc.image_row_pitch = va_arg(args_va, size_t);
-        } else if (g_strcmp0(key, "image_slice_pitch") == 0) {
-            image_dsc.image_slice_pitch = va_arg(args_va, size_t);
-        } else if (g_strcmp0(key, "num_mip_levels") == 0) {
-            image_dsc.num_mip_levels = va_arg(args_va, cl_uint);
-        } else if (g_strcmp0(key, "num_samples") == 0) {
-            image_dsc.num_samples = va_arg(args_va, cl_uint);
-        } else if (g_strcmp0(key, "memobj") == 0) {
-            image_dsc.memobj = va_arg(args_va, CCLMemObj *);
-        } else {
+        const struct ccl_image_key * img_key = ccl_image_key_lookup(key);
+
+        if (img_key == NULL) {
             g_set_error(err, CCL_ERROR, CCL_ERROR_ARGS,
                 "%s: unknown key '%s'", CCL_STRD, key);
             va_end(args_va);
             return NULL;
         }
+
+        /* Fetch the value according to its kind and store it in the
+         * respective image description field. */
+        switch (img_key->kind) {
+            case CCL_IMAGE_KEY_UINT:
+                G_STRUCT_MEMBER(cl_uint, &image_dsc, img_key->offset) =
+                    va_arg(args_va, cl_uint);
+                break;
+            case CCL_IMAGE_KEY_SIZET:
+                G_STRUCT_MEMBER(size_t, &image_dsc, img_key->offset) =
+                    va_arg(args_va, size_t);
+                break;
+            case CCL_IMAGE_KEY_MEMOBJ:
+                G_STRUCT_MEMBER(CCLMemObj *, &image_dsc, img_key->offset) =
+                    va_arg(args_va, CCLMemObj *);
+                break;
+        }
     }
 
     /* Close the va_list. */
@@ -616,72 +816,122 @@ finish:
 }
 
 /**
- * Copy image objects. This function wraps the clEnqueueCopyImage()
- * OpenCL function.
+ * @internal
  *
- * @public @memberof ccl_image
+ * @brief Transfer an image region between host memory and a mapped view
+ * of the image, avoiding the staging copy performed by the
+ * clEnqueueReadImage()/clEnqueueWriteImage() path on devices with
+ * host-accessible memory.
  *
- * @param[in] src_img Source image wrapper object.
- * @param[out] dst_img Destination image wrapper object.
- * @param[in] cq Command-queue wrapper object in which the copy command
- * will be queued.
- * @param[in] src_origin The @f$(x, y, z)@f$ offset in pixels in the 1D,
- * 2D, or 3D image source image, the @f$(x, y)@f$ offset and the image
- * index in the source image array or the @f$(x)@f$ offset and the image
- * index in the source 1D image array.
- * @param[in] dst_origin The @f$(x, y, z)@f$ offset in pixels in the 1D,
- * 2D, or 3D destination image, the @f$(x, y)@f$ offset and the image
- * index in the destination image array or the @f$(x)@f$ offset and the
- * image index in the 1D destination image array.
- * @param[in] region The @f$(width, height, depth)@f$ in pixels of the
- * 1D, 2D or 3D rectangle, the @f$(width, height)@f$ in pixels of the 2D
- * rectangle and the number of images of a 2D image array or the
- * @f$(width)@f$ in pixels of the 1D rectangle and the number of images
- * of a 1D image array.
+ * The image region is mapped (blocking), copied row by row with
+ * `memcpy()` honoring the host and mapped row/slice pitches, and
+ * unmapped. When the pitches of the host buffer and of the mapped
+ * region match, the whole region is copied with a single `memcpy()`.
+ *
+ * @private @memberof ccl_image
+ *
+ * @param[in,out] img Image wrapper object to transfer from/to.
+ * @param[in] cq Command-queue wrapper object in which the map and unmap
+ * commands will be queued.
+ * @param[in] map_flags `CL_MAP_READ` for a device-to-host transfer,
+ * `CL_MAP_WRITE` for a host-to-device transfer.
+ * @param[in] origin Region offset in pixels, as in
+ * ::ccl_image_enqueue_read().
+ * @param[in] region Region dimensions in pixels, as in
+ * ::ccl_image_enqueue_read().
+ * @param[in] host_row_pitch The length of each host buffer row in
+ * bytes, or zero if rows are tightly packed.
+ * @param[in] host_slice_pitch Size in bytes of each host buffer 2D
+ * slice, or zero if slices are tightly packed.
+ * @param[in,out] host_ptr Host buffer to transfer to/from.
  * @param[in,out] evt_wait_lst List of events that need to complete
- * before this command can be executed. The list will be cleared and
- * can be reused by client code.
+ * before the transfer can start. The list will be cleared and can be
+ * reused by client code.
  * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
  * reporting is to be ignored.
- * @return Event wrapper object that identifies this copy command.
+ * @return Event wrapper object that identifies the unmap command, i.e.
+ * the completion of the transfer.
  * */
-CCL_EXPORT
-CCLEvent * ccl_image_enqueue_copy(CCLImage * src_img, CCLImage * dst_img,
-    CCLQueue * cq, const size_t * src_origin, const size_t * dst_origin,
-    const size_t * region, CCLEventWaitList * evt_wait_lst,
-    CCLErr ** err) {
-
-    /* Make sure cq is not NULL. */
-    g_return_val_if_fail(cq != NULL, NULL);
-    /* Make sure src_img is not NULL. */
-    g_return_val_if_fail(src_img != NULL, NULL);
-    /* Make sure dst_img is not NULL. */
-    g_return_val_if_fail(dst_img != NULL, NULL);
-    /* Make sure err is NULL or it is not set. */
-    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+static CCLEvent * ccl_image_transfer_mapped(CCLImage * img, CCLQueue * cq,
+    cl_map_flags map_flags, const size_t * origin, const size_t * region,
+    size_t host_row_pitch, size_t host_slice_pitch, void * host_ptr,
+    CCLEventWaitList * evt_wait_lst, CCLErr ** err) {
 
-    /* OpenCL function status. */
-    cl_int ocl_status;
-    /* OpenCL event object. */
-    cl_event event = NULL;
     /* Event wrapper object. */
     CCLEvent * evt = NULL;
+    /* Mapped region. */
+    void * mapped = NULL;
+    /* Pitches of the mapped region. */
+    size_t map_row_pitch = 0;
+    size_t map_slice_pitch = 0;
+    /* Region geometry in bytes. */
+    size_t elem_size, row_bytes, num_rows, num_slices;
+    /* Internal error handling object. */
+    CCLErr * err_internal = NULL;
 
-    /* Copy image. */
-    ocl_status = clEnqueueCopyImage(ccl_queue_unwrap(cq),
-        ccl_memobj_unwrap(src_img), ccl_memobj_unwrap(dst_img),
-        src_origin, dst_origin, region,
-        ccl_event_wait_list_get_num_events(evt_wait_lst),
-        ccl_event_wait_list_get_clevents(evt_wait_lst), &event);
-    ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
-        CL_SUCCESS != ocl_status, ocl_status, error_handler,
-        "%s: unable to enqueue an image copy (OpenCL error %d: %s).",
-        CCL_STRD, ocl_status, ccl_err(ocl_status));
+    /* Get the size of each image element, in bytes. */
+    elem_size = ccl_image_get_info_scalar(
+        img, CL_IMAGE_ELEMENT_SIZE, size_t, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
 
-    /* Wrap event and associate it with the respective command queue.
-     * The event object will be released automatically when the command
-     * queue is released. */
-    evt = ccl_queue_produce_event(cq, event);
+    /* Map the image region into the host address space. The map is
+     * blocking, so the region can be copied immediately. */
+    mapped = ccl_image_enqueue_map(img, cq, CL_TRUE, map_flags, origin,
+        region, &map_row_pitch, &map_slice_pitch, evt_wait_lst, NULL,
+        &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Determine region geometry. For 1D and 2D images the unused
+     * region dimensions are 1, as required by the OpenCL API. */
+    row_bytes = region[0] * elem_size;
+    num_rows = region[1];
+    num_slices = region[2];
+
+    /* Zero host pitches mean tightly packed rows/slices. */
+    if (host_row_pitch == 0)
+        host_row_pitch = row_bytes;
+    if (host_slice_pitch == 0)
+        host_slice_pitch = host_row_pitch * num_rows;
+
+    /* For a 1D or 2D region the mapped slice pitch may be reported as
+     * zero; normalize it so the copy loop below can be generic. */
+    if (map_slice_pitch == 0)
+        map_slice_pitch = map_row_pitch * num_rows;
+
+    if ((host_row_pitch == map_row_pitch)
+        && ((num_slices == 1) || (host_slice_pitch == map_slice_pitch))) {
+
+        /* Host and mapped layouts match: copy the whole region at
+         * once. */
+        size_t total_bytes = (num_slices - 1) * map_slice_pitch
+            + (num_rows - 1) * map_row_pitch + row_bytes;
+        if (map_flags & CL_MAP_READ)
+            memcpy(host_ptr, mapped, total_bytes);
+        else
+            memcpy(mapped, host_ptr, total_bytes);
+
+    } else {
+
+        /* Layouts differ: copy row by row. */
+        for (size_t z = 0; z < num_slices; ++z) {
+            for (size_t y = 0; y < num_rows; ++y) {
+                unsigned char * host_row = (unsigned char *) host_ptr
+                    + z * host_slice_pitch + y * host_row_pitch;
+                unsigned char * map_row = (unsigned char *) mapped
+                    + z * map_slice_pitch + y * map_row_pitch;
+                if (map_flags & CL_MAP_READ)
+                    memcpy(host_row, map_row, row_bytes);
+                else
+                    memcpy(map_row, host_row, row_bytes);
+            }
+        }
+    }
+
+    /* Unmap the region. The returned event identifies the completion
+     * of the transfer. */
+    evt = ccl_memobj_enqueue_unmap(
+        (CCLMemObj *) img, cq, mapped, NULL, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
 
     /* If we got here, everything is OK. */
     g_assert(err == NULL || *err == NULL);
@@ -696,77 +946,688 @@ error_handler:
 
 finish:
 
-    /* Clear event wait list. */
-    ccl_event_wait_list_clear(evt_wait_lst);
-
     /* Return event. */
     return evt;
 }
 
 /**
- * Copy an image object to a buffer object. This function wraps the
- * clEnqueueCopyImageToBuffer() OpenCL function.
+ * Read from an image or image array object to host memory, using a
+ * zero-copy map/`memcpy()`/unmap sequence when possible.
+ *
+ * If the image was created by cf4ocl with the `CL_MEM_ALLOC_HOST_PTR`
+ * flag, the image memory is host-accessible and the read is performed
+ * by mapping the requested region with clEnqueueMapImage() and copying
+ * it with `memcpy()`, avoiding the staging copy which
+ * clEnqueueReadImage() implies on devices with unified memory (e.g.
+ * integrated GPUs). Otherwise, this function falls back to a blocking
+ * ::ccl_image_enqueue_read().
+ *
+ * In either case the read is blocking: when this function returns, the
+ * data is available in `ptr`.
  *
  * @public @memberof ccl_image
  *
- * @param[in] src_img Source image wrapper object where to read from.
- * @param[out] dst_buf Destination buffer wrapper object where to write
- * to.
- * @param[in] cq Command-queue wrapper object in which the copy command
+ * @param[in] img Image wrapper object where to read from.
+ * @param[in] cq Command-queue wrapper object in which the read command
  * will be queued.
- * @param[in] src_origin The @f$(x, y, z)@f$ offset in pixels in
- * the 1D, 2D or 3D image, the @f$(x, y)@f$ offset and the image index
- * in the 2D image array or the @f$(x)@f$ offset and the image index in
- * the 1D image array.
+ * @param[in] origin The @f$(x, y, z)@f$ offset in pixels in the 1D, 2D,
+ * or 3D image, the @f$(x, y)@f$ offset and the image index in the image
+ * array or the @f$(x)@f$ offset and the image index in the 1D image
+ * array.
  * @param[in] region The @f$(width, height, depth)@f$ in pixels of the
  * 1D, 2D or 3D rectangle, the @f$(width, height)@f$ in pixels of the 2D
  * rectangle and the number of images of a 2D image array or the
  * @f$(width)@f$ in pixels of the 1D rectangle and the number of images
  * of a 1D image array.
- * @param[in] dst_offset The offset where to begin copying data into
- * `dst_buf`.
+ * @param[in] row_pitch The length of each row in bytes, or zero if
+ * rows are tightly packed.
+ * @param[in] slice_pitch Size in bytes of each 2D slice of the region
+ * being read, or zero if slices are tightly packed.
+ * @param[out] ptr A pointer to a buffer in host memory where data is to
+ * be read into.
  * @param[in,out] evt_wait_lst List of events that need to complete
  * before this command can be executed. The list will be cleared and
  * can be reused by client code.
  * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
  * reporting is to be ignored.
- * @return Event wrapper object that identifies this copy command.
+ * @return Event wrapper object that identifies this read command.
  * */
 CCL_EXPORT
-CCLEvent * ccl_image_enqueue_copy_to_buffer(CCLImage * src_img,
-    CCLBuffer * dst_buf, CCLQueue * cq, const size_t * src_origin,
-    const size_t * region, size_t dst_offset,
-    CCLEventWaitList * evt_wait_lst, CCLErr ** err) {
+CCLEvent * ccl_image_enqueue_read_zerocopy(CCLImage * img, CCLQueue * cq,
+    const size_t * origin, const size_t * region, size_t row_pitch,
+    size_t slice_pitch, void * ptr, CCLEventWaitList * evt_wait_lst,
+    CCLErr ** err) {
 
-    /* Make sure cq is not NULL. */
-    g_return_val_if_fail(cq != NULL, NULL);
-    /* Make sure src_img is not NULL. */
-    g_return_val_if_fail(src_img != NULL, NULL);
-    /* Make sure dst_buf is not NULL. */
-    g_return_val_if_fail(dst_buf != NULL, NULL);
-    /* Make sure err is NULL or it is not set. */
-    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+    /* Make sure img is not NULL. */
+    g_return_val_if_fail(img != NULL, NULL);
 
-    /* OpenCL function status. */
-    cl_int ocl_status;
-    /* OpenCL event object. */
-    cl_event event = NULL;
-    /* Event wrapper object. */
-    CCLEvent * evt = NULL;
+    /* If the image memory is not known to be host-accessible, fall
+     * back to a plain blocking read. */
+    if ((!img->flags_cached) || !(img->flags & CL_MEM_ALLOC_HOST_PTR))
+        return ccl_image_enqueue_read(img, cq, CL_TRUE, origin, region,
+            row_pitch, slice_pitch, ptr, evt_wait_lst, err);
 
-    /* Copy image to buffer. */
-    ocl_status = clEnqueueCopyImageToBuffer(ccl_queue_unwrap(cq),
-        ccl_memobj_unwrap(src_img), ccl_memobj_unwrap(dst_buf),
-        src_origin, region, dst_offset,
-        ccl_event_wait_list_get_num_events(evt_wait_lst),
-        ccl_event_wait_list_get_clevents(evt_wait_lst), &event);
-    ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
-        CL_SUCCESS != ocl_status, ocl_status, error_handler,
-        "%s: unable to copy image to buffer (OpenCL error %d: %s).",
-        CCL_STRD, ocl_status, ccl_err(ocl_status));
+    /* Zero-copy path: map, copy, unmap. */
+    return ccl_image_transfer_mapped(img, cq, CL_MAP_READ, origin,
+        region, row_pitch, slice_pitch, ptr, evt_wait_lst, err);
+}
 
-    /* Wrap event and associate it with the respective command queue.
-     * The event object will be released automatically when the command
+/**
+ * Write to an image or image array object from host memory, using a
+ * zero-copy map/`memcpy()`/unmap sequence when possible.
+ *
+ * If the image was created by cf4ocl with the `CL_MEM_ALLOC_HOST_PTR`
+ * flag, the image memory is host-accessible and the write is performed
+ * by mapping the requested region with clEnqueueMapImage() and copying
+ * it with `memcpy()`, avoiding the staging copy which
+ * clEnqueueWriteImage() implies on devices with unified memory (e.g.
+ * integrated GPUs). Otherwise, this function falls back to a blocking
+ * ::ccl_image_enqueue_write().
+ *
+ * In either case the write is blocking: when this function returns,
+ * `ptr` can be reused by client code.
+ *
+ * @public @memberof ccl_image
+ *
+ * @param[out] img Image wrapper object where to write to.
+ * @param[in] cq Command-queue wrapper object in which the write command
+ * will be queued.
+ * @param[in] origin The @f$(x, y, z)@f$ offset in pixels in the 1D, 2D,
+ * or 3D image, the @f$(x, y)@f$ offset and the image index in the image
+ * array or the @f$(x)@f$ offset and the image index in the 1D image
+ * array.
+ * @param[in] region The @f$(width, height, depth)@f$ in pixels of the
+ * 1D, 2D or 3D rectangle, the @f$(width, height)@f$ in pixels of the 2D
+ * rectangle and the number of images of a 2D image array or the
+ * @f$(width)@f$ in pixels of the 1D rectangle and the number of images
+ * of a 1D image array.
+ * @param[in] input_row_pitch The length of each row in bytes, or zero
+ * if rows are tightly packed.
+ * @param[in] input_slice_pitch Size in bytes of each 2D slice of the
+ * region being written, or zero if slices are tightly packed.
+ * @param[in] ptr A pointer to a buffer in host memory where data is to
+ * be written from.
+ * @param[in,out] evt_wait_lst List of events that need to complete
+ * before this command can be executed. The list will be cleared and
+ * can be reused by client code.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return Event wrapper object that identifies this write command.
+ * */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_write_zerocopy(CCLImage * img, CCLQueue * cq,
+    const size_t * origin, const size_t * region, size_t input_row_pitch,
+    size_t input_slice_pitch, void * ptr, CCLEventWaitList * evt_wait_lst,
+    CCLErr ** err) {
+
+    /* Make sure img is not NULL. */
+    g_return_val_if_fail(img != NULL, NULL);
+
+    /* If the image memory is not known to be host-accessible, fall
+     * back to a plain blocking write. */
+    if ((!img->flags_cached) || !(img->flags & CL_MEM_ALLOC_HOST_PTR))
+        return ccl_image_enqueue_write(img, cq, CL_TRUE, origin, region,
+            input_row_pitch, input_slice_pitch, ptr, evt_wait_lst, err);
+
+    /* Zero-copy path: map, copy, unmap. */
+    return ccl_image_transfer_mapped(img, cq, CL_MAP_WRITE, origin,
+        region, input_row_pitch, input_slice_pitch, ptr, evt_wait_lst, err);
+}
+
+/**
+ * Map an image region for writing, copy host data into it honoring
+ * row/slice pitches, and unmap it, all in one call.
+ *
+ * This fuses the map/`memcpy()`/unmap sequence which callers of
+ * ::ccl_image_enqueue_map() typically perform by hand when uploading
+ * image data. On platforms with OpenCL >= 1.2 the region is mapped
+ * with `CL_MAP_WRITE_INVALIDATE_REGION`, so the implementation does
+ * not have to make the previous contents of the region visible in the
+ * mapping — for write-once uploads this avoids reading one full image
+ * worth of data back. Unlike
+ * ::ccl_image_enqueue_write_zerocopy(), this function always takes the
+ * map path, regardless of how the image was created.
+ *
+ * The copy is blocking: when this function returns, `host_src` can be
+ * reused by client code.
+ *
+ * @public @memberof ccl_image
+ *
+ * @param[out] img Image wrapper object where to write to.
+ * @param[in] cq Command-queue wrapper object in which the map and
+ * unmap commands will be queued.
+ * @param[in] origin The @f$(x, y, z)@f$ offset in pixels in the 1D, 2D,
+ * or 3D image, the @f$(x, y)@f$ offset and the image index in the image
+ * array or the @f$(x)@f$ offset and the image index in the 1D image
+ * array.
+ * @param[in] region The @f$(width, height, depth)@f$ in pixels of the
+ * 1D, 2D or 3D rectangle, the @f$(width, height)@f$ in pixels of the 2D
+ * rectangle and the number of images of a 2D image array or the
+ * @f$(width)@f$ in pixels of the 1D rectangle and the number of images
+ * of a 1D image array.
+ * @param[in] host_row_pitch The length of each host buffer row in
+ * bytes, or zero if rows are tightly packed.
+ * @param[in] host_slice_pitch Size in bytes of each host buffer 2D
+ * slice, or zero if slices are tightly packed.
+ * @param[in] host_src A pointer to a buffer in host memory where data
+ * is to be copied from.
+ * @param[in,out] evt_wait_lst List of events that need to complete
+ * before this command can be executed. The list will be cleared and
+ * can be reused by client code.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return Event wrapper object that identifies the unmap command, i.e.
+ * the completion of the upload.
+ * */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_map_copy(CCLImage * img, CCLQueue * cq,
+    const size_t * origin, const size_t * region, size_t host_row_pitch,
+    size_t host_slice_pitch, void * host_src,
+    CCLEventWaitList * evt_wait_lst, CCLErr ** err) {
+
+    /* Make sure img is not NULL. */
+    g_return_val_if_fail(img != NULL, NULL);
+    /* Make sure err is NULL or it is not set. */
+    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+
+    /* Map for writing. */
+    cl_map_flags map_flags = CL_MAP_WRITE;
+
+#ifdef CL_VERSION_1_2
+
+    /* Event wrapper object. */
+    CCLEvent * evt = NULL;
+    /* OpenCL version of the underlying platform. */
+    double ocl_ver;
+    /* Internal error handling object. */
+    CCLErr * err_internal = NULL;
+
+    /* If the platform supports it, map with
+     * CL_MAP_WRITE_INVALIDATE_REGION instead, which allows the
+     * implementation to skip making the previous contents of the
+     * region visible in the mapping. */
+    ocl_ver = ccl_memobj_get_opencl_version(
+        (CCLMemObj *) img, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+    if (ocl_ver >= 120)
+        map_flags = CL_MAP_WRITE_INVALIDATE_REGION;
+
+    /* Perform the fused map/copy/unmap. */
+    evt = ccl_image_transfer_mapped(img, cq, map_flags, origin, region,
+        host_row_pitch, host_slice_pitch, host_src, evt_wait_lst, err);
+
+    /* If we got here, everything is OK. */
+    goto finish;
+
+error_handler:
+    /* If we got here there was an error, verify that it is so. */
+    g_assert(err == NULL || *err != NULL);
+
+    /* An error occurred, return NULL to signal it. */
+    evt = NULL;
+
+finish:
+
+    /* Return event. */
+    return evt;
+
+#else
+
+    /* Perform the fused map/copy/unmap. */
+    return ccl_image_transfer_mapped(img, cq, map_flags, origin, region,
+        host_row_pitch, host_slice_pitch, host_src, evt_wait_lst, err);
+
+#endif
+
+}
+
+/**
+ * Write to an image or image array object from host memory, copying in
+ * 32×32 pixel tiles for cache locality.
+ *
+ * Like ::ccl_image_enqueue_write_zerocopy(), but when the zero-copy
+ * path is taken the region is copied in 32×32 pixel blocks instead of
+ * full rows. For large 2D images whose rows exceed the cache, the
+ * blocked traversal keeps both the host rows and the mapped rows of a
+ * tile resident while it is copied, turning a cache-thrashing scatter
+ * into mostly streaming writes.
+ *
+ * If the image was not created by cf4ocl with the
+ * `CL_MEM_ALLOC_HOST_PTR` flag, this function falls back to a blocking
+ * ::ccl_image_enqueue_write(). In either case the write is blocking:
+ * when this function returns, `ptr` can be reused by client code.
+ *
+ * @public @memberof ccl_image
+ *
+ * @param[out] img Image wrapper object where to write to.
+ * @param[in] cq Command-queue wrapper object in which the write command
+ * will be queued.
+ * @param[in] origin The @f$(x, y, z)@f$ offset in pixels in the 1D, 2D,
+ * or 3D image, the @f$(x, y)@f$ offset and the image index in the image
+ * array or the @f$(x)@f$ offset and the image index in the 1D image
+ * array.
+ * @param[in] region The @f$(width, height, depth)@f$ in pixels of the
+ * 1D, 2D or 3D rectangle, the @f$(width, height)@f$ in pixels of the 2D
+ * rectangle and the number of images of a 2D image array or the
+ * @f$(width)@f$ in pixels of the 1D rectangle and the number of images
+ * of a 1D image array.
+ * @param[in] input_row_pitch The length of each row in bytes, or zero
+ * if rows are tightly packed.
+ * @param[in] input_slice_pitch Size in bytes of each 2D slice of the
+ * region being written, or zero if slices are tightly packed.
+ * @param[in] ptr A pointer to a buffer in host memory where data is to
+ * be written from.
+ * @param[in,out] evt_wait_lst List of events that need to complete
+ * before this command can be executed. The list will be cleared and
+ * can be reused by client code.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return Event wrapper object that identifies this write command.
+ * */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_write_tiled(CCLImage * img, CCLQueue * cq,
+    const size_t * origin, const size_t * region, size_t input_row_pitch,
+    size_t input_slice_pitch, void * ptr, CCLEventWaitList * evt_wait_lst,
+    CCLErr ** err) {
+
+    /* Tile dimensions, in pixels. */
+    const size_t tile_dim = 32;
+
+    /* Make sure img is not NULL. */
+    g_return_val_if_fail(img != NULL, NULL);
+    /* Make sure err is NULL or it is not set. */
+    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+
+    /* Event wrapper object. */
+    CCLEvent * evt = NULL;
+    /* Mapped region. */
+    void * mapped = NULL;
+    /* Pitches of the mapped region. */
+    size_t map_row_pitch = 0;
+    size_t map_slice_pitch = 0;
+    /* Region geometry in bytes. */
+    size_t elem_size, num_rows, num_slices;
+    /* Internal error handling object. */
+    CCLErr * err_internal = NULL;
+
+    /* If the image memory is not known to be host-accessible, fall
+     * back to a plain blocking write. */
+    if ((!img->flags_cached) || !(img->flags & CL_MEM_ALLOC_HOST_PTR))
+        return ccl_image_enqueue_write(img, cq, CL_TRUE, origin, region,
+            input_row_pitch, input_slice_pitch, ptr, evt_wait_lst, err);
+
+    /* Get the size of each image element, in bytes. */
+    elem_size = ccl_image_get_info_scalar(
+        img, CL_IMAGE_ELEMENT_SIZE, size_t, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Map the image region into the host address space. The map is
+     * blocking, so the region can be copied immediately. */
+    mapped = ccl_image_enqueue_map(img, cq, CL_TRUE, CL_MAP_WRITE, origin,
+        region, &map_row_pitch, &map_slice_pitch, evt_wait_lst, NULL,
+        &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Determine region geometry. For 1D and 2D images the unused
+     * region dimensions are 1, as required by the OpenCL API. */
+    num_rows = region[1];
+    num_slices = region[2];
+
+    /* Zero host pitches mean tightly packed rows/slices. */
+    if (input_row_pitch == 0)
+        input_row_pitch = region[0] * elem_size;
+    if (input_slice_pitch == 0)
+        input_slice_pitch = input_row_pitch * num_rows;
+
+    /* For a 1D or 2D region the mapped slice pitch may be reported as
+     * zero; normalize it so the copy loop below can be generic. */
+    if (map_slice_pitch == 0)
+        map_slice_pitch = map_row_pitch * num_rows;
+
+    /* Copy the region in tile_dim x tile_dim pixel blocks. */
+    for (size_t z = 0; z < num_slices; ++z) {
+        for (size_t ty = 0; ty < num_rows; ty += tile_dim) {
+            size_t ty_end = MIN(ty + tile_dim, num_rows);
+            for (size_t tx = 0; tx < region[0]; tx += tile_dim) {
+                size_t tile_bytes =
+                    (MIN(tx + tile_dim, region[0]) - tx) * elem_size;
+                for (size_t y = ty; y < ty_end; ++y) {
+                    memcpy(
+                        (unsigned char *) mapped + z * map_slice_pitch
+                            + y * map_row_pitch + tx * elem_size,
+                        (unsigned char *) ptr + z * input_slice_pitch
+                            + y * input_row_pitch + tx * elem_size,
+                        tile_bytes);
+                }
+            }
+        }
+    }
+
+    /* Unmap the region. The returned event identifies the completion
+     * of the transfer. */
+    evt = ccl_memobj_enqueue_unmap(
+        (CCLMemObj *) img, cq, mapped, NULL, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* If we got here, everything is OK. */
+    g_assert(err == NULL || *err == NULL);
+    goto finish;
+
+error_handler:
+    /* If we got here there was an error, verify that it is so. */
+    g_assert(err == NULL || *err != NULL);
+
+    /* An error occurred, return NULL to signal it. */
+    evt = NULL;
+
+finish:
+
+    /* Return event. */
+    return evt;
+}
+
+/**
+ * Copy image objects. This function wraps the clEnqueueCopyImage()
+ * OpenCL function.
+ *
+ * @public @memberof ccl_image
+ *
+ * @param[in] src_img Source image wrapper object.
+ * @param[out] dst_img Destination image wrapper object.
+ * @param[in] cq Command-queue wrapper object in which the copy command
+ * will be queued.
+ * @param[in] src_origin The @f$(x, y, z)@f$ offset in pixels in the 1D,
+ * 2D, or 3D image source image, the @f$(x, y)@f$ offset and the image
+ * index in the source image array or the @f$(x)@f$ offset and the image
+ * index in the source 1D image array.
+ * @param[in] dst_origin The @f$(x, y, z)@f$ offset in pixels in the 1D,
+ * 2D, or 3D destination image, the @f$(x, y)@f$ offset and the image
+ * index in the destination image array or the @f$(x)@f$ offset and the
+ * image index in the 1D destination image array.
+ * @param[in] region The @f$(width, height, depth)@f$ in pixels of the
+ * 1D, 2D or 3D rectangle, the @f$(width, height)@f$ in pixels of the 2D
+ * rectangle and the number of images of a 2D image array or the
+ * @f$(width)@f$ in pixels of the 1D rectangle and the number of images
+ * of a 1D image array.
+ * @param[in,out] evt_wait_lst List of events that need to complete
+ * before this command can be executed. The list will be cleared and
+ * can be reused by client code.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return Event wrapper object that identifies this copy command.
+ * */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_copy(CCLImage * src_img, CCLImage * dst_img,
+    CCLQueue * cq, const size_t * src_origin, const size_t * dst_origin,
+    const size_t * region, CCLEventWaitList * evt_wait_lst,
+    CCLErr ** err) {
+
+    /* Make sure cq is not NULL. */
+    g_return_val_if_fail(cq != NULL, NULL);
+    /* Make sure src_img is not NULL. */
+    g_return_val_if_fail(src_img != NULL, NULL);
+    /* Make sure dst_img is not NULL. */
+    g_return_val_if_fail(dst_img != NULL, NULL);
+    /* Make sure err is NULL or it is not set. */
+    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+
+    /* OpenCL function status. */
+    cl_int ocl_status;
+    /* OpenCL event object. */
+    cl_event event = NULL;
+    /* Event wrapper object. */
+    CCLEvent * evt = NULL;
+
+    /* Copy image. */
+    ocl_status = clEnqueueCopyImage(ccl_queue_unwrap(cq),
+        ccl_memobj_unwrap(src_img), ccl_memobj_unwrap(dst_img),
+        src_origin, dst_origin, region,
+        ccl_event_wait_list_get_num_events(evt_wait_lst),
+        ccl_event_wait_list_get_clevents(evt_wait_lst), &event);
+    ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
+        CL_SUCCESS != ocl_status, ocl_status, error_handler,
+        "%s: unable to enqueue an image copy (OpenCL error %d: %s).",
+        CCL_STRD, ocl_status, ccl_err(ocl_status));
+
+    /* Wrap event and associate it with the respective command queue.
+     * The event object will be released automatically when the command
+     * queue is released. */
+    evt = ccl_queue_produce_event(cq, event);
+
+    /* If we got here, everything is OK. */
+    g_assert(err == NULL || *err == NULL);
+    goto finish;
+
+error_handler:
+    /* If we got here there was an error, verify that it is so. */
+    g_assert(err == NULL || *err != NULL);
+
+    /* An error occurred, return NULL to signal it. */
+    evt = NULL;
+
+finish:
+
+    /* Clear event wait list. */
+    ccl_event_wait_list_clear(evt_wait_lst);
+
+    /* Return event. */
+    return evt;
+}
+
+/**
+ * Copy an image region between two images accessed through different
+ * command queues, typically on different devices.
+ *
+ * The region is staged through a pinned host block allocated with
+ * ::ccl_aligned_alloc() and cached in the source image wrapper, so
+ * repeated copies of the same image reuse one allocation. A
+ * non-blocking read is enqueued on `src_cq` and the write on `dst_cq`
+ * waits on its event, allowing the two queues to overlap the transfer.
+ * If the queues belong to different contexts, where events cannot be
+ * shared, the read is waited upon on the host before the write is
+ * enqueued.
+ *
+ * @attention The staging block is reused by subsequent calls on the
+ * same source image. Client code must wait on the returned event before
+ * enqueuing another cross-device copy from the same image.
+ *
+ * @public @memberof ccl_image
+ *
+ * @param[in] src_img Source image wrapper object where to read from.
+ * @param[in] src_cq Command-queue wrapper object in which the read
+ * command will be queued.
+ * @param[out] dst_img Destination image wrapper object where to write
+ * to.
+ * @param[in] dst_cq Command-queue wrapper object in which the write
+ * command will be queued.
+ * @param[in] src_origin The @f$(x, y, z)@f$ offset in pixels in the
+ * source image, as in ::ccl_image_enqueue_read().
+ * @param[in] dst_origin The @f$(x, y, z)@f$ offset in pixels in the
+ * destination image, as in ::ccl_image_enqueue_write().
+ * @param[in] region The @f$(width, height, depth)@f$ in pixels of the
+ * region to copy, as in ::ccl_image_enqueue_copy().
+ * @param[in,out] evt_wait_lst List of events that need to complete
+ * before the read command can be executed. The list will be cleared and
+ * can be reused by client code.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return Event wrapper object that identifies the write command, i.e.
+ * the completion of the copy.
+ * */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_copy_cross_device(CCLImage * src_img,
+    CCLQueue * src_cq, CCLImage * dst_img, CCLQueue * dst_cq,
+    const size_t * src_origin, const size_t * dst_origin,
+    const size_t * region, CCLEventWaitList * evt_wait_lst,
+    CCLErr ** err) {
+
+    /* Make sure src_cq is not NULL. */
+    g_return_val_if_fail(src_cq != NULL, NULL);
+    /* Make sure dst_cq is not NULL. */
+    g_return_val_if_fail(dst_cq != NULL, NULL);
+    /* Make sure src_img is not NULL. */
+    g_return_val_if_fail(src_img != NULL, NULL);
+    /* Make sure dst_img is not NULL. */
+    g_return_val_if_fail(dst_img != NULL, NULL);
+    /* Make sure region is not NULL. */
+    g_return_val_if_fail(region != NULL, NULL);
+    /* Make sure err is NULL or it is not set. */
+    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+
+    /* Event wrapper objects for the read and write commands. */
+    CCLEvent * evt_read = NULL;
+    CCLEvent * evt = NULL;
+    /* Wait list holding the read event for the write command. */
+    CCLEventWaitList ewl = NULL;
+    /* Source and destination contexts. */
+    CCLContext * src_ctx = NULL;
+    CCLContext * dst_ctx = NULL;
+    /* Size of each image element (pixel), in bytes. */
+    size_t elem_size;
+    /* Size of staged region, in bytes. */
+    size_t total_bytes;
+    /* Internal error handling object. */
+    CCLErr * err_internal = NULL;
+
+    /* Determine the size of the region in bytes. Rows and slices are
+     * kept tightly packed in the staging block. */
+    elem_size = ccl_image_get_info_scalar(
+        src_img, CL_IMAGE_ELEMENT_SIZE, size_t, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+    total_bytes = region[0] * elem_size
+        * (region[1] > 0 ? region[1] : 1)
+        * (region[2] > 0 ? region[2] : 1);
+
+    /* Make sure the cached staging block exists and is large enough. */
+    if ((src_img->staging == NULL)
+        || (src_img->staging_size < total_bytes)) {
+        if (src_img->staging != NULL)
+            ccl_aligned_free(src_img->staging);
+        src_img->staging = ccl_aligned_alloc(total_bytes);
+        ccl_if_err_create_goto(*err, CCL_ERROR,
+            src_img->staging == NULL, CCL_ERROR_OTHER, error_handler,
+            "%s: unable to allocate %lu bytes of pinned staging memory.",
+            CCL_STRD, (unsigned long) total_bytes);
+        src_img->staging_size = total_bytes;
+    }
+
+    /* Enqueue a non-blocking read of the region into the staging
+     * block. This consumes and clears the caller's wait list. */
+    evt_read = ccl_image_enqueue_read(src_img, src_cq, CL_FALSE,
+        src_origin, region, 0, 0, src_img->staging, evt_wait_lst,
+        &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Determine if both queues belong to the same context, in which
+     * case the write can wait on the read event directly. */
+    src_ctx = ccl_queue_get_context(src_cq, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+    dst_ctx = ccl_queue_get_context(dst_cq, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Chain the read event into the write command. */
+    ccl_event_wait_list_add(&ewl, evt_read, NULL);
+    if (src_ctx != dst_ctx) {
+        /* Events cannot be shared between contexts, so wait for the
+         * read on the host before enqueuing the write. */
+        ccl_event_wait(&ewl, &err_internal);
+        ccl_if_err_propagate_goto(err, err_internal, error_handler);
+    }
+
+    /* Enqueue a non-blocking write of the staged region into the
+     * destination image. This consumes and clears the local wait
+     * list (already empty if the queues have different contexts). */
+    evt = ccl_image_enqueue_write(dst_img, dst_cq, CL_FALSE,
+        dst_origin, region, 0, 0, src_img->staging, &ewl,
+        &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* If we got here, everything is OK. */
+    g_assert(err == NULL || *err == NULL);
+    goto finish;
+
+error_handler:
+    /* If we got here there was an error, verify that it is so. */
+    g_assert(err == NULL || *err != NULL);
+
+    /* An error occurred, return NULL to signal it. */
+    evt = NULL;
+
+finish:
+
+    /* Clear event wait lists. These are no-ops if the lists were
+     * already consumed by the enqueue or wait functions. */
+    ccl_event_wait_list_clear(&ewl);
+    ccl_event_wait_list_clear(evt_wait_lst);
+
+    /* Return event. */
+    return evt;
+}
+
+/**
+ * Copy an image object to a buffer object. This function wraps the
+ * clEnqueueCopyImageToBuffer() OpenCL function.
+ *
+ * @public @memberof ccl_image
+ *
+ * @param[in] src_img Source image wrapper object where to read from.
+ * @param[out] dst_buf Destination buffer wrapper object where to write
+ * to.
+ * @param[in] cq Command-queue wrapper object in which the copy command
+ * will be queued.
+ * @param[in] src_origin The @f$(x, y, z)@f$ offset in pixels in
+ * the 1D, 2D or 3D image, the @f$(x, y)@f$ offset and the image index
+ * in the 2D image array or the @f$(x)@f$ offset and the image index in
+ * the 1D image array.
+ * @param[in] region The @f$(width, height, depth)@f$ in pixels of the
+ * 1D, 2D or 3D rectangle, the @f$(width, height)@f$ in pixels of the 2D
+ * rectangle and the number of images of a 2D image array or the
+ * @f$(width)@f$ in pixels of the 1D rectangle and the number of images
+ * of a 1D image array.
+ * @param[in] dst_offset The offset where to begin copying data into
+ * `dst_buf`.
+ * @param[in,out] evt_wait_lst List of events that need to complete
+ * before this command can be executed. The list will be cleared and
+ * can be reused by client code.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return Event wrapper object that identifies this copy command.
+ * */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_copy_to_buffer(CCLImage * src_img,
+    CCLBuffer * dst_buf, CCLQueue * cq, const size_t * src_origin,
+    const size_t * region, size_t dst_offset,
+    CCLEventWaitList * evt_wait_lst, CCLErr ** err) {
+
+    /* Make sure cq is not NULL. */
+    g_return_val_if_fail(cq != NULL, NULL);
+    /* Make sure src_img is not NULL. */
+    g_return_val_if_fail(src_img != NULL, NULL);
+    /* Make sure dst_buf is not NULL. */
+    g_return_val_if_fail(dst_buf != NULL, NULL);
+    /* Make sure err is NULL or it is not set. */
+    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+
+    /* OpenCL function status. */
+    cl_int ocl_status;
+    /* OpenCL event object. */
+    cl_event event = NULL;
+    /* Event wrapper object. */
+    CCLEvent * evt = NULL;
+
+    /* Copy image to buffer. */
+    ocl_status = clEnqueueCopyImageToBuffer(ccl_queue_unwrap(cq),
+        ccl_memobj_unwrap(src_img), ccl_memobj_unwrap(dst_buf),
+        src_origin, region, dst_offset,
+        ccl_event_wait_list_get_num_events(evt_wait_lst),
+        ccl_event_wait_list_get_clevents(evt_wait_lst), &event);
+    ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
+        CL_SUCCESS != ocl_status, ocl_status, error_handler,
+        "%s: unable to copy image to buffer (OpenCL error %d: %s).",
+        CCL_STRD, ocl_status, ccl_err(ocl_status));
+
+    /* Wrap event and associate it with the respective command queue.
+     * The event object will be released automatically when the command
      * queue is released. */
     evt = ccl_queue_produce_event(cq, event);
 
@@ -1006,4 +1867,232 @@ finish:
     return evt;
 }
 
+#ifdef CL_VERSION_1_2
+
+/**
+ * @internal
+ *
+ * @brief An axis-aligned box of image pixels, used by
+ * ccl_image_enqueue_fill_batch() to coalesce fill regions.
+ */
+struct ccl_image_fill_box {
+    size_t origin[3];
+    size_t region[3];
+};
+
+/**
+ * @internal
+ *
+ * @brief Merge box `b` into box `a` if the two boxes share a face,
+ * i.e. if they agree on two axes and are adjacent or overlapping along
+ * the third, so that their union is itself a box.
+ *
+ * @param[in,out] a First box, extended to the union if merging is
+ * possible.
+ * @param[in] b Second box.
+ * @return `CL_TRUE` if the boxes were merged, `CL_FALSE` otherwise.
+ * */
+static cl_bool ccl_image_fill_box_merge(
+    struct ccl_image_fill_box * a, const struct ccl_image_fill_box * b) {
+
+    /* Try each axis as the merge direction. */
+    for (int d = 0; d < 3; ++d) {
+
+        /* The other two axes must match exactly. */
+        int d1 = (d + 1) % 3;
+        int d2 = (d + 2) % 3;
+        if ((a->origin[d1] != b->origin[d1])
+            || (a->region[d1] != b->region[d1])
+            || (a->origin[d2] != b->origin[d2])
+            || (a->region[d2] != b->region[d2]))
+            continue;
+
+        /* The boxes must touch or overlap along the merge axis. */
+        if ((a->origin[d] + a->region[d] < b->origin[d])
+            || (b->origin[d] + b->region[d] < a->origin[d]))
+            continue;
+
+        /* Extend a to the union of both boxes. */
+        size_t end = MAX(
+            a->origin[d] + a->region[d], b->origin[d] + b->region[d]);
+        a->origin[d] = MIN(a->origin[d], b->origin[d]);
+        a->region[d] = end - a->origin[d];
+        return CL_TRUE;
+    }
+
+    /* The union of the boxes is not a box. */
+    return CL_FALSE;
+}
+
+#endif
+
+/**
+ * Fill several regions of an image object with the same color,
+ * coalescing mergeable regions into fewer clEnqueueFillImage() calls.
+ *
+ * Regions whose union is itself a box — e.g. adjacent tiles of a
+ * tile-based clearing pattern — are merged before being enqueued, so
+ * that a full-image clear split across many tiles collapses into a
+ * single driver dispatch. Regions may overlap, since they are all
+ * filled with the same color.
+ *
+ * @attention On an out-of-order command queue the returned event
+ * identifies only the last of the enqueued fill commands.
+ *
+ * @public @memberof ccl_image
+ * @note Requires OpenCL >= 1.2
+ *
+ * @param[out] img Image wrapper object to fill.
+ * @param[in] cq Command-queue wrapper object in which the fill commands
+ * will be queued.
+ * @param[in] fill_color The fill color.
+ * @param[in] origins Array of `num_regions` @f$(x, y, z)@f$ offsets in
+ * pixels, i.e. `3 * num_regions` values, as in
+ * ::ccl_image_enqueue_fill().
+ * @param[in] regions Array of `num_regions` @f$(width, height,
+ * depth)@f$ dimensions in pixels, i.e. `3 * num_regions` values, as in
+ * ::ccl_image_enqueue_fill().
+ * @param[in] num_regions Number of regions to fill.
+ * @param[in,out] evt_wait_lst List of events that need to complete
+ * before the fill commands can be executed. The list will be cleared
+ * and can be reused by client code.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return Event wrapper object that identifies the last enqueued fill
+ * command.
+ * */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_fill_batch(CCLImage * img, CCLQueue * cq,
+    const void * fill_color, const size_t * origins, const size_t * regions,
+    size_t num_regions, CCLEventWaitList * evt_wait_lst, CCLErr ** err) {
+
+    /* Make sure cq is not NULL. */
+    g_return_val_if_fail(cq != NULL, NULL);
+    /* Make sure img is not NULL. */
+    g_return_val_if_fail(img != NULL, NULL);
+    /* Make sure origins and regions are not NULL. */
+    g_return_val_if_fail(origins != NULL, NULL);
+    g_return_val_if_fail(regions != NULL, NULL);
+    /* Make sure there is at least one region. */
+    g_return_val_if_fail(num_regions > 0, NULL);
+    /* Make sure err is NULL or it is not set. */
+    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+
+    /* Event wrapper object. */
+    CCLEvent * evt = NULL;
+    /* Internal error handling object. */
+    CCLErr * err_internal = NULL;
+
+#ifndef CL_VERSION_1_2
+
+    CCL_UNUSED(fill_color);
+    CCL_UNUSED(err_internal);
+
+    /* If cf4ocl was not compiled with support for OpenCL >= 1.2, always throw
+     * error. */
+    ccl_if_err_create_goto(*err, CCL_ERROR, TRUE,
+        CCL_ERROR_UNSUPPORTED_OCL, error_handler,
+        "%s: Image fill requires cf4ocl to be deployed with "
+        "support for OpenCL version 1.2 or newer.",
+        CCL_STRD);
+
+#else
+
+    /* OpenCL function status. */
+    cl_int ocl_status;
+    /* OpenCL event object. */
+    cl_event event = NULL;
+    /* OpenCL version of the underlying platform. */
+    double ocl_ver;
+    /* Working array of fill boxes. */
+    struct ccl_image_fill_box * boxes = NULL;
+    /* Number of boxes left after merging. */
+    size_t num_boxes;
+    /* Did the last merging pass merge anything? */
+    cl_bool merged;
+
+    /* Check that context platform is >= OpenCL 1.2 */
+    ocl_ver = ccl_memobj_get_opencl_version(
+        (CCLMemObj *) img, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* If OpenCL version is not >= 1.2, throw error. */
+    ccl_if_err_create_goto(*err, CCL_ERROR, ocl_ver < 120,
+        CCL_ERROR_UNSUPPORTED_OCL, error_handler,
+        "%s: Image fill requires OpenCL version 1.2 or newer.",
+        CCL_STRD);
+
+    /* Copy the given regions into the working array. */
+    boxes = g_new(struct ccl_image_fill_box, num_regions);
+    for (size_t i = 0; i < num_regions; ++i) {
+        memcpy(boxes[i].origin, origins + 3 * i, 3 * sizeof(size_t));
+        memcpy(boxes[i].region, regions + 3 * i, 3 * sizeof(size_t));
+    }
+    num_boxes = num_regions;
+
+    /* Greedily merge boxes which share a face, until a full pass over
+     * all pairs merges nothing. */
+    do {
+        merged = CL_FALSE;
+        for (size_t i = 0; i < num_boxes; ++i) {
+            for (size_t j = i + 1; j < num_boxes; ++j) {
+                if (ccl_image_fill_box_merge(&boxes[i], &boxes[j])) {
+                    /* Remove box j, replacing it with the last box. */
+                    boxes[j] = boxes[num_boxes - 1];
+                    num_boxes--;
+                    j--;
+                    merged = CL_TRUE;
+                }
+            }
+        }
+    } while (merged);
+
+    /* Enqueue one fill command per remaining box. Only the last
+     * command produces an event. */
+    for (size_t i = 0; i < num_boxes; ++i) {
+        ocl_status = clEnqueueFillImage(ccl_queue_unwrap(cq),
+            ccl_memobj_unwrap(img), fill_color,
+            boxes[i].origin, boxes[i].region,
+            ccl_event_wait_list_get_num_events(evt_wait_lst),
+            ccl_event_wait_list_get_clevents(evt_wait_lst),
+            i == num_boxes - 1 ? &event : NULL);
+        ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
+            CL_SUCCESS != ocl_status, ocl_status, error_handler,
+            "%s: unable to enqueue a fill image command "
+            "(OpenCL error %d: %s).",
+            CCL_STRD, ocl_status, ccl_err(ocl_status));
+    }
+
+    /* Wrap event and associate it with the respective command queue.
+     * The event object will be released automatically when the command
+     * queue is released. */
+    evt = ccl_queue_produce_event(cq, event);
+
+#endif
+
+    /* If we got here, everything is OK. */
+    g_assert(err == NULL || *err == NULL);
+    goto finish;
+
+error_handler:
+    /* If we got here there was an error, verify that it is so. */
+    g_assert(err == NULL || *err != NULL);
+
+    /* An error occurred, return NULL to signal it. */
+    evt = NULL;
+
+finish:
+
+#ifdef CL_VERSION_1_2
+    /* Release the working array of fill boxes. */
+    g_free(boxes);
+#endif
+
+    /* Clear event wait list. */
+    ccl_event_wait_list_clear(evt_wait_lst);
+
+    /* Return event. */
+    return evt;
+}
+
 /** @} */
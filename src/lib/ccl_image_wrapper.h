@@ -223,6 +223,76 @@ CCLImage * ccl_image_new(CCLContext * ctx, cl_mem_flags flags,
     const cl_image_format * image_format, void * host_ptr, CCLErr ** err,
     ...);
 
+#ifdef CL_VERSION_1_2
+
+/**
+ * Creates a new image wrapper object for an image which the host will
+ * never read or write, e.g. an intermediate image in a device-side
+ * pipeline.
+ *
+ * This macro works like ::ccl_image_new(), additionally setting the
+ * `CL_MEM_HOST_NO_ACCESS` flag. This lets the driver allocate the
+ * image in device memory that is never made host-coherent, improving
+ * device-side cache utilization. Transfer functions such as
+ * ::ccl_image_enqueue_read() will fail on the resulting image.
+ *
+ * @relates ccl_image
+ * @note Requires OpenCL >= 1.2
+ *
+ * @param[in] ctx A context wrapper object.
+ * @param[in] flags Specifies allocation and usage information about the
+ * image wrapper object being created.
+ * @param[in] image_format A pointer to the OpenCL `cl_image_format`
+ * structure, which describes format properties of the image to be
+ * allocated.
+ * @param[in] host_ptr A pointer to the image data that may already be
+ * allocated by the application.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @param[in] ... A `NULL`-terminated list of key-value pairs which
+ * describe the image, as accepted by ::ccl_image_new().
+ * @return A new image wrapper object or `NULL` if an error occurs.
+ * */
+#define ccl_image_new_device_only(ctx, flags, image_format, host_ptr, \
+    err, ...) \
+    ccl_image_new((ctx), (flags) | CL_MEM_HOST_NO_ACCESS, \
+        (image_format), (host_ptr), (err), __VA_ARGS__)
+
+/**
+ * Creates a new image wrapper object for an image which the host only
+ * writes, e.g. an input image initialized by the host and then only
+ * read by kernels.
+ *
+ * This macro works like ::ccl_image_new(), additionally setting the
+ * `CL_MEM_HOST_WRITE_ONLY` flag. This lets the driver place the image
+ * in write-combined host-visible memory, which speeds up host writes
+ * at the cost of making host reads very slow. Use only for images the
+ * host never reads back.
+ *
+ * @relates ccl_image
+ * @note Requires OpenCL >= 1.2
+ *
+ * @param[in] ctx A context wrapper object.
+ * @param[in] flags Specifies allocation and usage information about the
+ * image wrapper object being created.
+ * @param[in] image_format A pointer to the OpenCL `cl_image_format`
+ * structure, which describes format properties of the image to be
+ * allocated.
+ * @param[in] host_ptr A pointer to the image data that may already be
+ * allocated by the application.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @param[in] ... A `NULL`-terminated list of key-value pairs which
+ * describe the image, as accepted by ::ccl_image_new().
+ * @return A new image wrapper object or `NULL` if an error occurs.
+ * */
+#define ccl_image_new_write_combined(ctx, flags, image_format, host_ptr, \
+    err, ...) \
+    ccl_image_new((ctx), (flags) | CL_MEM_HOST_WRITE_ONLY, \
+        (image_format), (host_ptr), (err), __VA_ARGS__)
+
+#endif
+
 /* Read from an image or image array object to host memory. */
 CCL_EXPORT
 CCLEvent * ccl_image_enqueue_read(CCLImage * img, CCLQueue * cq,
@@ -237,6 +307,38 @@ CCLEvent * ccl_image_enqueue_write(CCLImage * img, CCLQueue * cq,
     size_t input_row_pitch, size_t input_slice_pitch, void * ptr,
     CCLEventWaitList * evt_wait_lst, CCLErr ** err);
 
+/* Read from an image or image array object to host memory, using a
+ * zero-copy map/memcpy/unmap sequence when possible. */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_read_zerocopy(CCLImage * img, CCLQueue * cq,
+    const size_t * origin, const size_t * region, size_t row_pitch,
+    size_t slice_pitch, void * ptr, CCLEventWaitList * evt_wait_lst,
+    CCLErr ** err);
+
+/* Write to an image or image array object from host memory, using a
+ * zero-copy map/memcpy/unmap sequence when possible. */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_write_zerocopy(CCLImage * img, CCLQueue * cq,
+    const size_t * origin, const size_t * region, size_t input_row_pitch,
+    size_t input_slice_pitch, void * ptr, CCLEventWaitList * evt_wait_lst,
+    CCLErr ** err);
+
+/* Map an image region for writing, copy host data into it honoring
+ * row/slice pitches, and unmap it, all in one call. */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_map_copy(CCLImage * img, CCLQueue * cq,
+    const size_t * origin, const size_t * region, size_t host_row_pitch,
+    size_t host_slice_pitch, void * host_src,
+    CCLEventWaitList * evt_wait_lst, CCLErr ** err);
+
+/* Write to an image or image array object from host memory, copying
+ * in 32x32 pixel tiles for cache locality. */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_write_tiled(CCLImage * img, CCLQueue * cq,
+    const size_t * origin, const size_t * region, size_t input_row_pitch,
+    size_t input_slice_pitch, void * ptr, CCLEventWaitList * evt_wait_lst,
+    CCLErr ** err);
+
 /* Copy image objects. This function wraps the clEnqueueCopyImage()
  * OpenCL function. */
 CCL_EXPORT
@@ -244,6 +346,14 @@ CCLEvent * ccl_image_enqueue_copy(CCLImage * src_img, CCLImage * dst_img,
     CCLQueue * cq, const size_t * src_origin, const size_t * dst_origin,
     const size_t * region, CCLEventWaitList * evt_wait_lst, CCLErr ** err);
 
+/* Copy an image region between two images accessed through different
+ * command queues, staged through a cached pinned host block. */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_copy_cross_device(CCLImage * src_img,
+    CCLQueue * src_cq, CCLImage * dst_img, CCLQueue * dst_cq,
+    const size_t * src_origin, const size_t * dst_origin,
+    const size_t * region, CCLEventWaitList * evt_wait_lst, CCLErr ** err);
+
 /* Copy an image object to a buffer object. */
 CCL_EXPORT
 CCLEvent * ccl_image_enqueue_copy_to_buffer(CCLImage * src_img,
@@ -267,6 +377,13 @@ CCLEvent * ccl_image_enqueue_fill(CCLImage * img, CCLQueue * cq,
     const void * fill_color, const size_t * origin, const size_t * region,
     CCLEventWaitList * evt_wait_lst, CCLErr ** err);
 
+/* Fill several regions of an image object with the same color,
+ * coalescing mergeable regions into fewer fill commands. */
+CCL_EXPORT
+CCLEvent * ccl_image_enqueue_fill_batch(CCLImage * img, CCLQueue * cq,
+    const void * fill_color, const size_t * origins, const size_t * regions,
+    size_t num_regions, CCLEventWaitList * evt_wait_lst, CCLErr ** err);
+
 /**
  * Enqueues a command to unmap a previously mapped image object. This
  * is a utility macro that expands to ::ccl_memobj_enqueue_unmap(),
@@ -27,6 +27,7 @@
  * */
 
 #include "ccl_kernel_arg.h"
+#include "_ccl_kernel_arg.h"
 #include "_ccl_abstract_wrapper.h"
 
 /**
@@ -109,6 +110,26 @@ void ccl_arg_destroy(CCLArg * arg) {
     }
 }
 
+/**
+ * @internal
+ *
+ * @brief Determine if argument is a real wrapper object (buffer, image
+ * or sampler), rather than a local/private argument created with
+ * ccl_arg_new() or the ::ccl_arg_skip constant.
+ *
+ * @param[in] arg Kernel argument to check.
+ * @return `CL_TRUE` if argument is a wrapper object, `CL_FALSE`
+ * otherwise.
+ * */
+cl_bool ccl_arg_is_wrapper(CCLArg * arg) {
+
+    /* Make sure arg is not NULL. */
+    g_return_val_if_fail(arg != NULL, CL_FALSE);
+
+    return (arg != ccl_arg_skip) && !ccl_arg_is_local(arg)
+        ? CL_TRUE : CL_FALSE;
+}
+
 /**
  * Get size in bytes of kernel argument.
  *
@@ -25,11 +25,31 @@
  * @copyright [GNU Lesser General Public License version 3 (LGPLv3)](http://www.gnu.org/licenses/lgpl.html)
  * */
 
+#include <string.h>
+
 #include "ccl_kernel_wrapper.h"
 #include "ccl_program_wrapper.h"
 #include "_ccl_abstract_wrapper.h"
+#include "_ccl_kernel_arg.h"
 #include "_ccl_defs.h"
 
+/**
+ * @internal
+ *
+ * @brief Number of per-device workgroup information cache slots kept in
+ * each kernel wrapper.
+ */
+#define CCL_KERNEL_WG_CACHE_SIZE 4
+
+/**
+ * @internal
+ *
+ * @brief Number of kernel argument indices tracked by the dirty-mask
+ * fast path. Arguments with higher indices fall back to the argument
+ * hash table.
+ */
+#define CCL_KERNEL_ARGS_MASKED 64
+
 /**
  * Kernel wrapper class.
  *
@@ -44,10 +64,74 @@ struct ccl_kernel {
     CCLWrapper base;
 
     /**
-     * Kernel arguments.
+     * Pending kernel arguments with index at or above
+     * ::CCL_KERNEL_ARGS_MASKED, stored densely at
+     * `args_ext[arg_index - CCL_KERNEL_ARGS_MASKED]`. `NULL` until an
+     * argument with such an index is set. Arguments with lower indices
+     * are kept in `args_vec`.
      * @private
      * */
-    GHashTable * args;
+    CCLArg ** args_ext;
+
+    /**
+     * Number of slots in `args_ext`.
+     * @private
+     * */
+    cl_uint args_ext_cap;
+
+    /**
+     * Bitmap of pending arguments in `args_ext`, one bit per slot in
+     * `(args_ext_cap + 63) / 64` words. Lets the submit loop jump
+     * straight to staged slots instead of scanning for non-`NULL`
+     * entries.
+     * @private
+     * */
+    guint64 * args_ext_dirty;
+
+    /**
+     * Pending (staged, not yet submitted) kernel arguments with index
+     * below ::CCL_KERNEL_ARGS_MASKED.
+     * @private
+     * */
+    CCLArg * args_vec[CCL_KERNEL_ARGS_MASKED];
+
+    /**
+     * Bitmask of pending arguments in `args_vec`.
+     * @private
+     * */
+    guint64 args_dirty;
+
+    /**
+     * Hash of the value last staged or submitted for each argument in
+     * `args_vec`, or zero if none. Used to skip re-submission of
+     * unchanged arguments.
+     * @private
+     * */
+    guint64 args_hash[CCL_KERNEL_ARGS_MASKED];
+
+    /**
+     * Cached workgroup information per device, immutable for a given
+     * (kernel, device) pair. Unused slots have a `NULL` device. The
+     * generic wrapper information cache cannot hold these values, as
+     * it is keyed by parameter only, not by device.
+     * @private
+     * */
+    struct {
+        cl_device_id device;
+        size_t wg_size_max;
+        size_t wg_size_mult;
+    } wg_cache[CCL_KERNEL_WG_CACHE_SIZE];
+
+    /**
+     * Cached argument information, keyed by argument index and
+     * parameter name packed into 64 bits. The generic wrapper
+     * information cache cannot hold these values, as it is keyed by
+     * parameter only, not by argument index. Values are borrowed from
+     * the wrapper information table, which owns them. `NULL` until the
+     * first argument information query.
+     * @private
+     * */
+    GHashTable * arg_info_cache;
 
 };
 
@@ -66,10 +150,74 @@ static void ccl_kernel_release_fields(CCLKernel * krnl) {
     /* Make sure krnl wrapper object is not NULL. */
     g_return_if_fail(krnl != NULL);
 
-    /* Free kernel arguments. */
-    if (krnl->args != NULL)
-        g_hash_table_destroy(krnl->args);
+    /* Free kernel arguments with high indices. */
+    if (krnl->args_ext != NULL) {
+        for (cl_uint i = 0; i < krnl->args_ext_cap; ++i)
+            if (krnl->args_ext[i] != NULL)
+                ccl_arg_destroy(krnl->args_ext[i]);
+        g_free(krnl->args_ext);
+        g_free(krnl->args_ext_dirty);
+    }
+
+    /* Free pending kernel arguments in the dirty-mask fast path. */
+    for (guint i = 0; i < CCL_KERNEL_ARGS_MASKED; ++i)
+        if (krnl->args_vec[i] != NULL)
+            ccl_arg_destroy(krnl->args_vec[i]);
+
+    /* Free the argument information cache. The cached information
+     * objects themselves are owned by the wrapper information table. */
+    if (krnl->arg_info_cache != NULL)
+        g_hash_table_destroy(krnl->arg_info_cache);
+
+}
+
+/**
+ * @internal
+ *
+ * @brief Return the index of the lowest set bit of a non-zero 64-bit
+ * mask.
+ *
+ * @param[in] mask A non-zero 64-bit mask.
+ * @return Index of the lowest set bit.
+ * */
+static inline cl_uint ccl_kernel_mask_lsb(guint64 mask) {
+
+#ifdef __GNUC__
+    return (cl_uint) __builtin_ctzll(mask);
+#else
+    cl_uint i = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/**
+ * @internal
+ *
+ * @brief Hash the value of a kernel argument, i.e. the exact bytes
+ * which would be passed to clSetKernelArg(). For memory object,
+ * sampler, etc. arguments these are the bytes of the OpenCL handle,
+ * so two wrappers of the same OpenCL object hash equally. Never
+ * returns zero, which is reserved as the "no value" marker.
+ *
+ * @param[in] arg Kernel argument to hash.
+ * @return 64-bit hash (FNV-1a) of the argument value.
+ * */
+static guint64 ccl_kernel_arg_hash(CCLArg * arg) {
+
+    const unsigned char * bytes = (const unsigned char *) ccl_arg_value(arg);
+    size_t size = ccl_arg_size(arg);
+    guint64 hash = G_GUINT64_CONSTANT(0xcbf29ce484222325);
 
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= G_GUINT64_CONSTANT(0x100000001b3);
+    }
+
+    return (hash != 0) ? hash : 1;
 }
 
 /**
@@ -202,17 +350,67 @@ CCL_EXPORT
 void ccl_kernel_set_arg(CCLKernel * krnl, cl_uint arg_index, void * arg) {
 
     /* Make sure krnl is not NULL. */
-    g_return_if_fail(krnl != NULL);
+    ccl_return_if_fail(krnl != NULL);
+
+    /* Fast path for low argument indices: stage the argument in a
+     * dense array with a dirty bitmask, and skip it entirely if its
+     * value hash shows it is identical to the value last submitted for
+     * this index. */
+    if (arg_index < CCL_KERNEL_ARGS_MASKED) {
+
+        guint64 bit = G_GUINT64_CONSTANT(1) << arg_index;
+        guint64 hash = ccl_kernel_arg_hash((CCLArg *) arg);
+
+        /* If the argument value was already submitted for this index
+         * and no other value has been staged since, don't re-submit
+         * it. */
+        if ((hash == krnl->args_hash[arg_index])
+            && !(krnl->args_dirty & bit)) {
+            if (arg != (void *) krnl->args_vec[arg_index])
+                ccl_arg_destroy((CCLArg *) arg);
+            return;
+        }
+
+        /* Replace any previously staged argument for this index. */
+        if ((krnl->args_vec[arg_index] != NULL)
+            && (krnl->args_vec[arg_index] != (CCLArg *) arg))
+            ccl_arg_destroy(krnl->args_vec[arg_index]);
+
+        /* Stage argument and mark it dirty. */
+        krnl->args_vec[arg_index] = (CCLArg *) arg;
+        krnl->args_hash[arg_index] = hash;
+        krnl->args_dirty |= bit;
+        return;
+    }
 
-    /* Initialize table of kernel arguments if necessary. */
-    if (krnl->args == NULL) {
-        krnl->args = g_hash_table_new_full(g_direct_hash,
-            g_direct_equal, NULL, (GDestroyNotify) ccl_arg_destroy);
+    /* High argument indices go into the dense overflow array, indexed
+     * by arg_index - CCL_KERNEL_ARGS_MASKED. Grow it if necessary,
+     * zero-filling the new slots. */
+    cl_uint slot = arg_index - CCL_KERNEL_ARGS_MASKED;
+    if (slot >= krnl->args_ext_cap) {
+        cl_uint new_cap = MAX(slot + 1, krnl->args_ext_cap * 2);
+        cl_uint old_words = (krnl->args_ext_cap + 63) / 64;
+        cl_uint new_words = (new_cap + 63) / 64;
+        krnl->args_ext = g_realloc_n(
+            krnl->args_ext, new_cap, sizeof(CCLArg *));
+        memset(krnl->args_ext + krnl->args_ext_cap, 0,
+            (new_cap - krnl->args_ext_cap) * sizeof(CCLArg *));
+        krnl->args_ext_dirty = g_realloc_n(
+            krnl->args_ext_dirty, new_words, sizeof(guint64));
+        memset(krnl->args_ext_dirty + old_words, 0,
+            (new_words - old_words) * sizeof(guint64));
+        krnl->args_ext_cap = new_cap;
     }
 
-    /* Keep argument in table. */
-    g_hash_table_replace(krnl->args, GUINT_TO_POINTER(arg_index),
-        (gpointer) arg);
+    /* Replace any previously staged argument for this index. */
+    if ((krnl->args_ext[slot] != NULL)
+        && (krnl->args_ext[slot] != (CCLArg *) arg))
+        ccl_arg_destroy(krnl->args_ext[slot]);
+
+    /* Keep argument in the overflow array and mark it pending. */
+    krnl->args_ext[slot] = (CCLArg *) arg;
+    krnl->args_ext_dirty[slot / 64] |=
+        G_GUINT64_CONSTANT(1) << (slot % 64);
 }
 
 /**
@@ -248,38 +446,41 @@ void ccl_kernel_set_args(CCLKernel * krnl, ...) {
     /* Make sure krnl is not NULL. */
     g_return_if_fail(krnl != NULL);
 
+    /* Maximum number of arguments staged on the stack. Kernels with
+     * more arguments than this fall back to a heap-allocated array. */
+    #define CCL_KERNEL_ARGS_STAGED 32
+
     /* The va_list, which represents the variable argument list. */
     va_list args_va;
+    /* Stack staging array for the common case, avoiding a heap
+     * allocation per call. */
+    void * args_staged[CCL_KERNEL_ARGS_STAGED + 1];
     /* Array of arguments, created from the va_list. */
-    void ** args_array = NULL;
+    void ** args_array = args_staged;
     /* Number of arguments. */
     guint num_args = 0;
     /* Aux. arg. when cycling through the va_list. */
     void * aux_arg;
 
-    /* Initialize the va_list. */
-    va_start(args_va, krnl);
+    /* 1. Determine number of arguments. */
 
-    /* Get first argument. */
+    va_start(args_va, krnl);
     aux_arg = va_arg(args_va, void *);
+    while (aux_arg != NULL) {
+        num_args++;
+        aux_arg = va_arg(args_va, void *);
+    }
+    va_end(args_va);
 
-    /* Check if any arguments are given, and if so, populate array
-     * of arguments. */
-    if (aux_arg != NULL) {
-
-        /* 1. Determine number of arguments. */
-
-        while (aux_arg != NULL) {
-            num_args++;
-            aux_arg = va_arg(args_va, void *);
-        }
-        va_end(args_va);
+    /* If any arguments are given... */
+    if (num_args > 0) {
 
         /* 2. Populate array of arguments. */
 
-        args_array = g_slice_alloc((num_args + 1) * sizeof(void *));
-        va_start(args_va, krnl);
+        if (num_args > CCL_KERNEL_ARGS_STAGED)
+            args_array = g_slice_alloc((num_args + 1) * sizeof(void *));
 
+        va_start(args_va, krnl);
         for (guint i = 0; i < num_args; ++i) {
             aux_arg = va_arg(args_va, void *);
             args_array[i] = aux_arg;
@@ -287,23 +488,17 @@ void ccl_kernel_set_args(CCLKernel * krnl, ...) {
         va_end(args_va);
         args_array[num_args] = NULL;
 
-    } else {
-
-        /* Close the variable argument list if no arguments are given. */
-        va_end(args_va);
-    }
-
-    /* If any arguments are given... */
-    if (num_args > 0) {
-
         /* Call the array version of this function.*/
         ccl_kernel_set_args_v(krnl, args_array);
 
-        /* Free the array of arguments. */
-        g_slice_free1((num_args + 1) * sizeof(void *), args_array);
+        /* Free the array of arguments, if heap-allocated. */
+        if (args_array != args_staged)
+            g_slice_free1((num_args + 1) * sizeof(void *), args_array);
 
     }
 
+    #undef CCL_KERNEL_ARGS_STAGED
+
 }
 
 /**
@@ -352,6 +547,208 @@ void ccl_kernel_set_args_v(CCLKernel * krnl, void ** args) {
     }
 }
 
+/**
+ * Forget all cached kernel argument state.
+ *
+ * Pending arguments which were staged with ::ccl_kernel_set_arg() but
+ * not yet submitted are discarded, and the record of previously
+ * submitted argument values is cleared, so the next
+ * ::ccl_kernel_set_arg() call for any index will always reach
+ * clSetKernelArg(). Use this if the kernel arguments were changed
+ * behind the wrapper's back, e.g. with a direct clSetKernelArg() call.
+ *
+ * @warning This function is not thread-safe. For multi-threaded
+ * access to the same kernel function, create multiple instances of
+ * a kernel wrapper for the given kernel function with
+ * ::ccl_kernel_new(), one for each thread.
+ *
+ * @public @memberof ccl_kernel
+ *
+ * @param[in] krnl A kernel wrapper object.
+ * */
+CCL_EXPORT
+void ccl_kernel_reset_arg_cache(CCLKernel * krnl) {
+
+    /* Make sure krnl is not NULL. */
+    g_return_if_fail(krnl != NULL);
+
+    /* Discard pending arguments and value hashes in the dirty-mask
+     * fast path. */
+    for (guint i = 0; i < CCL_KERNEL_ARGS_MASKED; ++i) {
+        if (krnl->args_vec[i] != NULL) {
+            ccl_arg_destroy(krnl->args_vec[i]);
+            krnl->args_vec[i] = NULL;
+        }
+        krnl->args_hash[i] = 0;
+    }
+    krnl->args_dirty = 0;
+
+    /* Discard pending arguments kept in the overflow array. */
+    for (cl_uint i = 0; i < krnl->args_ext_cap; ++i) {
+        if (krnl->args_ext[i] != NULL) {
+            ccl_arg_destroy(krnl->args_ext[i]);
+            krnl->args_ext[i] = NULL;
+        }
+    }
+    if (krnl->args_ext_dirty != NULL)
+        memset(krnl->args_ext_dirty, 0,
+            ((krnl->args_ext_cap + 63) / 64) * sizeof(guint64));
+}
+
+/**
+ * @internal
+ *
+ * @brief Report a clSetKernelArg() failure in a ::CCLErr object.
+ *
+ * Kept out of line and cold, so the argument-submission loops in
+ * ::ccl_kernel_flush_args() carry only the status test inline and not
+ * the message-formatting code.
+ *
+ * @private @memberof ccl_kernel
+ *
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @param[in] arg_index Index of the argument which could not be set.
+ * @param[in] ocl_status Status code returned by clSetKernelArg().
+ * */
+CCL_COLD CCL_NOINLINE
+static void ccl_kernel_report_setarg_error(
+    CCLErr ** err, cl_uint arg_index, cl_int ocl_status) {
+
+    g_set_error(err, CCL_OCL_ERROR, ocl_status,
+        "%s: unable to set kernel arg %d (OpenCL error %d: %s).",
+        CCL_STRD, arg_index, ocl_status, ccl_err(ocl_status));
+    g_debug(G_ERR_DEBUG_STR);
+}
+
+/**
+ * @internal
+ *
+ * @brief Submit all pending kernel arguments with clSetKernelArg().
+ *
+ * @private @memberof ccl_kernel
+ *
+ * @param[in] krnl A kernel wrapper object.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return `CL_TRUE` if all pending arguments were submitted
+ * successfully, `CL_FALSE` otherwise.
+ * */
+static cl_bool ccl_kernel_flush_args(CCLKernel * krnl, CCLErr ** err) {
+
+    /* OpenCL status flag. */
+    cl_int ocl_status;
+
+    /* Set pending kernel arguments staged in the dirty-mask fast
+     * path. The mask is iterated via its lowest set bit, so only dirty
+     * arguments are visited. The (index, size, value) triples are
+     * first gathered into parallel stack arrays, so the subsequent
+     * clSetKernelArg() calls are issued back-to-back without argument
+     * pointer chasing or allocator calls between them. */
+    if (krnl->args_dirty != 0) {
+
+        cl_uint pending_idx[CCL_KERNEL_ARGS_MASKED];
+        size_t pending_size[CCL_KERNEL_ARGS_MASKED];
+        const void * pending_value[CCL_KERNEL_ARGS_MASKED];
+        cl_uint num_pending = 0;
+        cl_uint i;
+        cl_kernel kernel = ccl_kernel_unwrap(krnl);
+
+        /* First pass: gather pending arguments. */
+        while (krnl->args_dirty != 0) {
+            cl_uint arg_index = ccl_kernel_mask_lsb(krnl->args_dirty);
+            CCLArg * arg = krnl->args_vec[arg_index];
+            krnl->args_dirty &= ~(G_GUINT64_CONSTANT(1) << arg_index);
+            pending_idx[num_pending] = arg_index;
+            pending_size[num_pending] = ccl_arg_size(arg);
+            pending_value[num_pending] = ccl_arg_value(arg);
+            num_pending++;
+        }
+
+        /* Second pass: issue the clSetKernelArg() calls in a tight,
+         * branch-free loop. The status codes are folded into a single
+         * accumulator checked once after the loop, so the
+         * success-dominated path carries no per-iteration branch. */
+        cl_int acc_status = CL_SUCCESS;
+        for (i = 0; i < num_pending; ++i)
+            acc_status |= clSetKernelArg(kernel, pending_idx[i],
+                pending_size[i], pending_value[i]);
+
+        /* On the rare failure, walk the arguments again to find the
+         * first failing index and its status code. Setting an argument
+         * is idempotent, so re-issuing the successful calls is
+         * harmless; if the second walk fails nowhere, the arguments
+         * are all set and the launch can proceed. */
+        ocl_status = CL_SUCCESS;
+        i = num_pending;
+        if (G_UNLIKELY(acc_status != CL_SUCCESS)) {
+            for (i = 0; i < num_pending; ++i) {
+                ocl_status = clSetKernelArg(kernel, pending_idx[i],
+                    pending_size[i], pending_value[i]);
+                if (ocl_status != CL_SUCCESS) break;
+            }
+        }
+
+        /* Consume all gathered arguments regardless of status, so a
+         * failed argument is not re-submitted or double-freed later.
+         * Arguments which were not successfully submitted have their
+         * value hash discarded. */
+        for (cl_uint j = 0; j < num_pending; ++j) {
+            cl_uint arg_index = pending_idx[j];
+            CCLArg * arg = krnl->args_vec[arg_index];
+            krnl->args_vec[arg_index] = NULL;
+            ccl_arg_destroy(arg);
+            if ((ocl_status != CL_SUCCESS) && (j >= i))
+                krnl->args_hash[arg_index] = 0;
+        }
+
+        if (G_UNLIKELY(ocl_status != CL_SUCCESS)) {
+            ccl_kernel_report_setarg_error(err,
+                i < num_pending ? pending_idx[i] : 0, ocl_status);
+            goto error_handler;
+        }
+    }
+
+    /* Set pending kernel arguments kept in the overflow array. The
+     * dirty bitmap is iterated word by word via the lowest set bit, so
+     * only staged slots are visited. */
+    if (krnl->args_ext != NULL) {
+        cl_uint num_words = (krnl->args_ext_cap + 63) / 64;
+        cl_kernel kernel = ccl_kernel_unwrap(krnl);
+        for (cl_uint w = 0; w < num_words; ++w) {
+            while (krnl->args_ext_dirty[w] != 0) {
+                cl_uint b = ccl_kernel_mask_lsb(krnl->args_ext_dirty[w]);
+                cl_uint slot = w * 64 + b;
+                CCLArg * arg = krnl->args_ext[slot];
+                cl_uint arg_index = slot + CCL_KERNEL_ARGS_MASKED;
+                ocl_status = clSetKernelArg(kernel,
+                    arg_index, ccl_arg_size(arg), ccl_arg_value(arg));
+                /* Consume the staged argument regardless of status, so
+                 * a failed argument is not re-submitted or double-freed
+                 * later. */
+                krnl->args_ext_dirty[w] &= ~(G_GUINT64_CONSTANT(1) << b);
+                krnl->args_ext[slot] = NULL;
+                ccl_arg_destroy(arg);
+                if (G_UNLIKELY(ocl_status != CL_SUCCESS)) {
+                    ccl_kernel_report_setarg_error(
+                        err, arg_index, ocl_status);
+                    goto error_handler;
+                }
+            }
+        }
+    }
+
+    /* If we got here, everything is OK. */
+    g_assert(err == NULL || *err == NULL);
+    return CL_TRUE;
+
+error_handler:
+
+    /* If we got here there was an error, verify that it is so. */
+    g_assert(err == NULL || *err != NULL);
+    return CL_FALSE;
+}
+
 /**
  * Enqueues a kernel for execution on a device.
  *
@@ -394,11 +791,11 @@ CCLEvent * ccl_kernel_enqueue_ndrange(CCLKernel * krnl, CCLQueue * cq,
     CCLEventWaitList * evt_wait_lst, CCLErr ** err) {
 
     /* Make sure krnl is not NULL. */
-    g_return_val_if_fail(krnl != NULL, NULL);
+    ccl_return_val_if_fail(krnl != NULL, NULL);
     /* Make sure cq is not NULL. */
-    g_return_val_if_fail(cq != NULL, NULL);
+    ccl_return_val_if_fail(cq != NULL, NULL);
     /* Make sure err is NULL or it is not set. */
-    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+    ccl_return_val_if_fail(err == NULL || *err == NULL, NULL);
 
     /* OpenCL status flag. */
     cl_int ocl_status;
@@ -407,33 +804,28 @@ CCLEvent * ccl_kernel_enqueue_ndrange(CCLKernel * krnl, CCLQueue * cq,
     cl_event event;
     /* Event wrapper. */
     CCLEvent * evt;
+    /* Number of events in the wait list, and the raw event array. */
+    cl_uint num_evts = 0;
+    const cl_event * evts = NULL;
+    /* Internal error handling object. */
+    CCLErr * err_internal = NULL;
 
-    /* Iterator for table of kernel arguments. */
-    GHashTableIter iter;
-    gpointer arg_index_ptr, arg_ptr;
-
-    /* Set pending kernel arguments. */
-    if (krnl->args != NULL) {
-        g_hash_table_iter_init(&iter, krnl->args);
-        while (g_hash_table_iter_next(&iter, &arg_index_ptr, &arg_ptr)) {
-            cl_uint arg_index = GPOINTER_TO_UINT(arg_index_ptr);
-            CCLArg * arg = (CCLArg *) arg_ptr;
-            ocl_status = clSetKernelArg(ccl_kernel_unwrap(krnl), arg_index,
-                ccl_arg_size(arg), ccl_arg_value(arg));
-            ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
-                CL_SUCCESS != ocl_status, ocl_status, error_handler,
-                "%s: unable to set kernel arg %d (OpenCL error %d: %s).",
-                CCL_STRD, arg_index, ocl_status, ccl_err(ocl_status));
-            g_hash_table_iter_remove(&iter);
-        }
+    /* Submit pending kernel arguments. */
+    ccl_kernel_flush_args(krnl, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Marshal the event wait list, skipping the helper calls for the
+     * common case of no wait list — e.g. an in-order queue where
+     * commands are implicitly ordered. */
+    if (G_UNLIKELY((evt_wait_lst != NULL) && (*evt_wait_lst != NULL))) {
+        num_evts = ccl_event_wait_list_get_num_events(evt_wait_lst);
+        evts = ccl_event_wait_list_get_clevents(evt_wait_lst);
     }
 
     /* Run kernel. */
     ocl_status = clEnqueueNDRangeKernel(ccl_queue_unwrap(cq),
         ccl_kernel_unwrap(krnl), work_dim, global_work_offset,
-        global_work_size, local_work_size,
-        ccl_event_wait_list_get_num_events(evt_wait_lst),
-        ccl_event_wait_list_get_clevents(evt_wait_lst), &event);
+        global_work_size, local_work_size, num_evts, evts, &event);
     ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
         CL_SUCCESS != ocl_status, ocl_status, error_handler,
         "%s: unable to enqueue kernel (OpenCL error %d: %s).",
@@ -458,19 +850,353 @@ error_handler:
 
 finish:
 
+    /* Clear event wait list, if a non-empty one was given. The emptiness
+     * test is done here, so the common no-wait-list launch elides the
+     * call altogether. */
+    if (G_UNLIKELY((evt_wait_lst != NULL) && (*evt_wait_lst != NULL)))
+        ccl_event_wait_list_clear(evt_wait_lst);
+
+    /* Return evt. */
+    return evt;
+}
+
+/**
+ * Enqueues a kernel for execution on a device, without producing an
+ * event.
+ *
+ * This function works like ::ccl_kernel_enqueue_ndrange(), but asks
+ * the OpenCL implementation for no event identifying the command, and
+ * consequently allocates no event wrapper. Useful for launch loops on
+ * in-order queues, where the completion of a launch is implied by the
+ * completion of the commands which follow it.
+ *
+ * @warning This function is not thread-safe. For multi-threaded
+ * access to the same kernel function, create multiple instances of
+ * a kernel wrapper for the given kernel function with
+ * ::ccl_kernel_new(), one for each thread.
+ *
+ * @public @memberof ccl_kernel
+ *
+ * @param[in] krnl A kernel wrapper object.
+ * @param[in] cq A command queue wrapper object.
+ * @param[in] work_dim The number of dimensions used to specify the
+ * global work-items and work-items in the work-group.
+ * @param[in] global_work_offset Can be used to specify an array of
+ * `work_dim` unsigned values that describe the offset used to calculate
+ * the global ID of a work-item.
+ * @param[in] global_work_size An array of `work_dim` unsigned values
+ * that describe the number of global work-items in `work_dim`
+ * dimensions that will execute the kernel function.
+ * @param[in] local_work_size An array of `work_dim` unsigned values
+ * that describe the number of work-items that make up a work-group that
+ * will execute the specified kernel.
+ * @param[in,out] evt_wait_lst List of events that need to complete
+ * before this command can be executed. The list will be cleared and
+ * can be reused by client code.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return `CL_TRUE` if the kernel was enqueued successfully, `CL_FALSE`
+ * otherwise.
+ * */
+CCL_EXPORT
+cl_bool ccl_kernel_enqueue_ndrange_no_event(CCLKernel * krnl, CCLQueue * cq,
+    cl_uint work_dim, const size_t * global_work_offset,
+    const size_t * global_work_size, const size_t * local_work_size,
+    CCLEventWaitList * evt_wait_lst, CCLErr ** err) {
+
+    /* Make sure krnl is not NULL. */
+    ccl_return_val_if_fail(krnl != NULL, CL_FALSE);
+    /* Make sure cq is not NULL. */
+    ccl_return_val_if_fail(cq != NULL, CL_FALSE);
+    /* Make sure err is NULL or it is not set. */
+    ccl_return_val_if_fail(err == NULL || *err == NULL, CL_FALSE);
+
+    /* OpenCL status flag. */
+    cl_int ocl_status;
+
+    /* Function return status. */
+    cl_bool ret_status;
+    /* Number of events in the wait list, and the raw event array. */
+    cl_uint num_evts = 0;
+    const cl_event * evts = NULL;
+    /* Internal error handling object. */
+    CCLErr * err_internal = NULL;
+
+    /* Submit pending kernel arguments. */
+    ccl_kernel_flush_args(krnl, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Marshal the event wait list, skipping the helper calls for the
+     * common case of no wait list. */
+    if (G_UNLIKELY((evt_wait_lst != NULL) && (*evt_wait_lst != NULL))) {
+        num_evts = ccl_event_wait_list_get_num_events(evt_wait_lst);
+        evts = ccl_event_wait_list_get_clevents(evt_wait_lst);
+    }
+
+    /* Run kernel, requesting no event. */
+    ocl_status = clEnqueueNDRangeKernel(ccl_queue_unwrap(cq),
+        ccl_kernel_unwrap(krnl), work_dim, global_work_offset,
+        global_work_size, local_work_size, num_evts, evts, NULL);
+    ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
+        CL_SUCCESS != ocl_status, ocl_status, error_handler,
+        "%s: unable to enqueue kernel (OpenCL error %d: %s).",
+        CCL_STRD, ocl_status, ccl_err(ocl_status));
+
+    /* If we got here, everything is OK. */
+    g_assert(err == NULL || *err == NULL);
+    ret_status = CL_TRUE;
+    goto finish;
+
+error_handler:
+
+    /* If we got here there was an error, verify that it is so. */
+    g_assert(err == NULL || *err != NULL);
+    ret_status = CL_FALSE;
+
+finish:
+
+    /* Clear event wait list, if a non-empty one was given. The emptiness
+     * test is done here, so the common no-wait-list launch elides the
+     * call altogether. */
+    if (G_UNLIKELY((evt_wait_lst != NULL) && (*evt_wait_lst != NULL)))
+        ccl_event_wait_list_clear(evt_wait_lst);
+
+    /* Return status. */
+    return ret_status;
+}
+
+/**
+ * Enqueue a chain of kernels with minimal event dependencies.
+ *
+ * The kernels are enqueued in the given order, but instead of
+ * serializing them blindly, this function derives the event
+ * dependencies between them from the memory objects they share: each
+ * kernel only waits for the most recent earlier kernel in the chain
+ * which references one of its buffer, image or sampler arguments.
+ * Kernels which share no memory objects get no event edge between
+ * them, so on a command queue created with
+ * `CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE` the device is free to
+ * overlap them (e.g. run a transfer on the copy engine while an
+ * independent kernel computes). On an in-order queue the function
+ * still works correctly, but no overlap will take place.
+ *
+ * The arguments of each kernel are given in `args`, as a
+ * `NULL`-terminated array per kernel in the same format accepted by
+ * ::ccl_kernel_set_args_v(), and are set by this function. The
+ * dependency analysis only sees these arrays: it does not distinguish
+ * reads from writes (sharing any memory object creates an edge, which
+ * is conservative but always correct), and arguments hidden behind
+ * ::ccl_arg_skip do not generate edges. If the argument array for a
+ * kernel is `NULL`, nothing is known about what it touches, so it is
+ * treated as a full barrier: it waits for all previous kernels in the
+ * chain, and all following kernels wait for it.
+ *
+ * Kernels with no dependencies within the chain wait on the events in
+ * `evt_wait_lst`, so the caller can gate the whole chain on previous
+ * commands.
+ *
+ * @public @memberof ccl_kernel
+ *
+ * @warning This function is not thread-safe in what concerns the
+ * kernel wrapper objects. For multi-threaded access to the same kernel
+ * function, create multiple instances of a kernel wrapper for the
+ * given kernel function with ::ccl_kernel_new(), one for each thread.
+ *
+ * @param[in] cq A command queue wrapper object, preferably created
+ * with `CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE`.
+ * @param[in] krnls Array of `num_krnls` kernel wrapper objects.
+ * @param[in] args Array of `num_krnls` `NULL`-terminated argument
+ * arrays, one per kernel (individual entries may be `NULL`, see
+ * above), or `NULL`, which is equivalent to all entries being `NULL`.
+ * @param[in] num_krnls Number of kernels in the chain.
+ * @param[in] work_dims Array of `num_krnls` work dimensions, one per
+ * kernel.
+ * @param[in] global_work_offsets Array of `num_krnls` global work
+ * offset arrays, one per kernel (individual entries may be `NULL`), or
+ * `NULL`.
+ * @param[in] global_work_sizes Array of `num_krnls` global work size
+ * arrays, one per kernel.
+ * @param[in] local_work_sizes Array of `num_krnls` local work size
+ * arrays, one per kernel (individual entries may be `NULL`), or
+ * `NULL`.
+ * @param[out] evts Array of `num_krnls` event wrapper objects, one per
+ * enqueued kernel, or `NULL` if the individual events are of no
+ * interest.
+ * @param[in,out] evt_wait_lst List of events that need to complete
+ * before the chain can start. The list will be cleared and can be
+ * reused by client code.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return Event wrapper object that identifies the last kernel in the
+ * chain, or `NULL` if an error occurs. Note that with out-of-order
+ * queues this event does not imply completion of the whole chain; use
+ * the `evts` array or a marker for that.
+ * */
+CCL_EXPORT
+CCLEvent * ccl_kernel_chain_enqueue(CCLQueue * cq, CCLKernel ** krnls,
+    void *** args, cl_uint num_krnls, const cl_uint * work_dims,
+    const size_t ** global_work_offsets, const size_t ** global_work_sizes,
+    const size_t ** local_work_sizes, CCLEvent ** evts,
+    CCLEventWaitList * evt_wait_lst, CCLErr ** err) {
+
+    /* Make sure cq is not NULL. */
+    g_return_val_if_fail(cq != NULL, NULL);
+    /* Make sure krnls is not NULL and the chain is not empty. */
+    g_return_val_if_fail(krnls != NULL, NULL);
+    g_return_val_if_fail(num_krnls > 0, NULL);
+    /* Make sure the per-kernel shape arrays are given. */
+    g_return_val_if_fail(work_dims != NULL, NULL);
+    g_return_val_if_fail(global_work_sizes != NULL, NULL);
+    /* Make sure err is NULL or it is not set. */
+    g_return_val_if_fail(err == NULL || *err == NULL, NULL);
+
+    /* Event wrapper of the last enqueued kernel. */
+    CCLEvent * evt = NULL;
+    /* Map of each memory object to the event of the last kernel in the
+     * chain which referenced it. */
+    GHashTable * last_user = NULL;
+    /* Events of all kernels enqueued so far. */
+    GPtrArray * chain_evts = NULL;
+    /* Unwrapped memory objects referenced by the current kernel's
+     * arguments. Gathered before the arguments are staged, because
+     * staging and submission destroy the private/local CCLArg objects,
+     * so the argument array cannot be re-read after the enqueue. */
+    GPtrArray * krnl_objs = NULL;
+    /* Event of the last kernel with unknown arguments, which acts as a
+     * barrier within the chain. */
+    cl_event barrier_evt = NULL;
+    /* Events in the caller's wait list, gating the chain roots. */
+    cl_uint num_user_evts;
+    const cl_event * user_evts;
+    /* Internal error handling object. */
+    CCLErr * err_internal = NULL;
+
+    num_user_evts = ccl_event_wait_list_get_num_events(evt_wait_lst);
+    user_evts = ccl_event_wait_list_get_clevents(evt_wait_lst);
+
+    last_user = g_hash_table_new(g_direct_hash, g_direct_equal);
+    chain_evts = g_ptr_array_sized_new(num_krnls);
+    krnl_objs = g_ptr_array_new();
+
+    /* Enqueue each kernel with its minimal wait list. */
+    for (cl_uint i = 0; i < num_krnls; ++i) {
+
+        /* This kernel's argument array, if known. */
+        void ** krnl_args = (args != NULL) ? args[i] : NULL;
+        /* This kernel's wait list. Built directly as an array of
+         * `cl_event`, which is what ::CCLEventWaitList holds. */
+        CCLEventWaitList ewl = g_ptr_array_new();
+
+        if (krnl_args != NULL) {
+
+            /* Gather dependencies: for each memory object argument,
+             * wait for the last kernel in the chain which referenced
+             * it. The objects themselves are remembered in krnl_objs
+             * for the post-enqueue bookkeeping below. */
+            g_ptr_array_set_size(krnl_objs, 0);
+            for (guint j = 0; krnl_args[j] != NULL; ++j) {
+                CCLArg * arg = (CCLArg *) krnl_args[j];
+                gpointer obj, dep;
+                gboolean dup = FALSE;
+                if ((arg == ccl_arg_skip) || !ccl_arg_is_wrapper(arg))
+                    continue;
+                obj = ccl_wrapper_unwrap((CCLWrapper *) arg);
+                g_ptr_array_add(krnl_objs, obj);
+                dep = g_hash_table_lookup(last_user, obj);
+                if (dep == NULL)
+                    continue;
+                /* Avoid duplicate events in the wait list. */
+                for (guint k = 0; k < ewl->len; ++k)
+                    if (ewl->pdata[k] == dep) {
+                        dup = TRUE;
+                        break;
+                    }
+                if (!dup)
+                    g_ptr_array_add(ewl, dep);
+            }
+
+            /* An intervening kernel with unknown arguments orders all
+             * kernels which follow it. */
+            if (barrier_evt != NULL)
+                g_ptr_array_add(ewl, (gpointer) barrier_evt);
+
+            /* Set this kernel's arguments. */
+            ccl_kernel_set_args_v(krnls[i], krnl_args);
+
+        } else {
+
+            /* Unknown arguments: this kernel may touch anything, so
+             * wait for every kernel enqueued so far. */
+            for (guint k = 0; k < chain_evts->len; ++k)
+                g_ptr_array_add(ewl, chain_evts->pdata[k]);
+        }
+
+        /* Chain roots wait on the caller's wait list instead. */
+        if (ewl->len == 0)
+            for (cl_uint k = 0; k < num_user_evts; ++k)
+                g_ptr_array_add(ewl, (gpointer) user_evts[k]);
+
+        /* Enqueue the kernel. This clears (recycles) the internal wait
+         * list. */
+        evt = ccl_kernel_enqueue_ndrange(krnls[i], cq, work_dims[i],
+            (global_work_offsets != NULL) ? global_work_offsets[i] : NULL,
+            global_work_sizes[i],
+            (local_work_sizes != NULL) ? local_work_sizes[i] : NULL,
+            &ewl, &err_internal);
+        ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+        /* Record this kernel's event as the last user of each of its
+         * memory objects, using the object list gathered before the
+         * arguments were consumed. */
+        if (krnl_args != NULL) {
+            for (guint j = 0; j < krnl_objs->len; ++j) {
+                g_hash_table_insert(last_user, krnl_objs->pdata[j],
+                    (gpointer) ccl_event_unwrap(evt));
+            }
+        } else {
+            barrier_evt = ccl_event_unwrap(evt);
+        }
+
+        g_ptr_array_add(chain_evts, (gpointer) ccl_event_unwrap(evt));
+        if (evts != NULL)
+            evts[i] = evt;
+    }
+
+    /* If we got here, everything is OK. */
+    g_assert(err == NULL || *err == NULL);
+    goto finish;
+
+error_handler:
+
+    /* If we got here there was an error, verify that it is so. */
+    g_assert(err == NULL || *err != NULL);
+
+    /* An error occurred, return NULL to signal it. */
+    evt = NULL;
+
+finish:
+
+    /* Free the dependency tracking structures. */
+    if (last_user != NULL)
+        g_hash_table_destroy(last_user);
+    if (chain_evts != NULL)
+        g_ptr_array_free(chain_evts, TRUE);
+    if (krnl_objs != NULL)
+        g_ptr_array_free(krnl_objs, TRUE);
+
     /* Clear event wait list. */
     ccl_event_wait_list_clear(evt_wait_lst);
 
-    /* Return evt. */
+    /* Return the event of the last kernel in the chain. */
     return evt;
 }
 
 /**
  * Set kernel arguments and enqueue it for execution on a device.
  *
- * Internally this function sets kernel arguments by calling
- * ::ccl_kernel_set_args_v(), and enqueues the kernel for execution
- * by calling ::ccl_kernel_enqueue_ndrange().
+ * Internally this function stages each argument in the variable
+ * argument list with ::ccl_kernel_set_arg(), and enqueues the kernel
+ * for execution by calling ::ccl_kernel_enqueue_ndrange().
  *
  * The ::ccl_kernel_set_args_and_enqueue_ndrange_v() function performs
  * the same operation but accepts an array of arguments instead.
@@ -527,61 +1253,27 @@ CCLEvent * ccl_kernel_set_args_and_enqueue_ndrange(
     CCLEvent * evt;
     /* The va_list, which represents the variable argument list. */
     va_list args_va;
-    /* Array of arguments, to be created from the va_list. */
-    void ** args_array = NULL;
-    /* Number of arguments. */
-    guint num_args = 0;
     /* Aux. arg. when cycling through the va_list. */
     void * aux_arg;
+    /* Argument index. */
+    guint i = 0;
 
-    /* Initialize the va_list. */
+    /* Stage the arguments directly from the va_list, with no
+     * intermediate argument array: a single traversal hands each
+     * argument to ::ccl_kernel_set_arg(), where the usual value-hash
+     * check still filters out redundant submissions. */
     va_start(args_va, err);
-
-    /* Get first argument. */
-    aux_arg = va_arg(args_va, void *);
-
-    /* Check if any arguments are given, and if so, populate array
-     * of arguments. */
-    if (aux_arg != NULL) {
-
-        /* 1. Determine number of arguments. */
-
-        while (aux_arg != NULL) {
-            num_args++;
-            aux_arg = va_arg(args_va, void *);
-        }
-        va_end(args_va);
-
-        /* 2. Populate array of arguments. */
-
-        args_array = g_slice_alloc((num_args + 1) * sizeof(void *));
-        va_start(args_va, err);
-
-        for (guint i = 0; i < num_args; ++i) {
-            aux_arg = va_arg(args_va, void *);
-            args_array[i] = aux_arg;
-        }
-        va_end(args_va);
-        args_array[num_args] = NULL;
-
-    } else {
-
-        /* Close the variable argument list if no arguments are given. */
-        va_end(args_va);
+    while ((aux_arg = va_arg(args_va, void *)) != NULL) {
+        if (aux_arg != ccl_arg_skip)
+            ccl_kernel_set_arg(krnl, i, aux_arg);
+        i++;
     }
+    va_end(args_va);
 
-    /* Set kernel arguments and run it. */
-    evt = ccl_kernel_set_args_and_enqueue_ndrange_v(krnl, cq, work_dim,
+    /* Enqueue kernel. */
+    evt = ccl_kernel_enqueue_ndrange(krnl, cq, work_dim,
         global_work_offset, global_work_size, local_work_size,
-        evt_wait_lst, args_array, err);
-
-    /* If any arguments are given... */
-    if (num_args > 0) {
-
-        /* Free the array of arguments. */
-        g_slice_free1((num_args + 1) * sizeof(void *), args_array);
-
-    }
+        evt_wait_lst, err);
 
     /* Return event wrapper. */
     return evt;
@@ -952,43 +1644,75 @@ cl_bool ccl_kernel_suggest_worksizes(CCLKernel * krnl, CCLDevice * dev,
      * and capabilities. */
     if (krnl != NULL) {
 
-        /* Determine maximum workgroup size. */
-        wg_size_max = ccl_kernel_get_workgroup_info_scalar(krnl, dev,
-            CL_KERNEL_WORK_GROUP_SIZE, size_t, &err_internal);
-        ccl_if_err_not_info_unavailable_propagate_goto(
-            err, err_internal, error_handler);
+        /* These values are immutable for a given (kernel, device)
+         * pair, so check the kernel's workgroup information cache
+         * before reaching into the OpenCL implementation. */
+        cl_device_id dev_id = ccl_device_unwrap(dev);
+        gint slot = -1;
+        gboolean cached = FALSE;
+
+        for (gint i = 0; i < CCL_KERNEL_WG_CACHE_SIZE; ++i) {
+            if (krnl->wg_cache[i].device == dev_id) {
+                wg_size_max = krnl->wg_cache[i].wg_size_max;
+                wg_size_mult = krnl->wg_cache[i].wg_size_mult;
+                cached = TRUE;
+                break;
+            } else if ((krnl->wg_cache[i].device == NULL) && (slot < 0)) {
+                slot = i;
+            }
+        }
+
+        if (!cached) {
+
+            /* Determine maximum workgroup size. */
+            wg_size_max = ccl_kernel_get_workgroup_info_scalar(krnl, dev,
+                CL_KERNEL_WORK_GROUP_SIZE, size_t, &err_internal);
+            ccl_if_err_not_info_unavailable_propagate_goto(
+                err, err_internal, error_handler);
 
 #ifdef CL_VERSION_1_1
 
-        /* Determine preferred workgroup size multiple (OpenCL >= 1.1). */
+            /* Determine preferred workgroup size multiple
+             * (OpenCL >= 1.1). */
 
-        /* Get OpenCL version of the underlying platform. */
-        cl_uint ocl_ver = ccl_kernel_get_opencl_version(krnl, &err_internal);
-        ccl_if_err_propagate_goto(err, err_internal, error_handler);
+            /* Get OpenCL version of the underlying platform. */
+            cl_uint ocl_ver =
+                ccl_kernel_get_opencl_version(krnl, &err_internal);
+            ccl_if_err_propagate_goto(err, err_internal, error_handler);
 
-        /* If OpenCL version of the underlying platform is >= 1.1 ... */
-        if (ocl_ver >= 110) {
+            /* If OpenCL version of the underlying platform
+             * is >= 1.1 ... */
+            if (ocl_ver >= 110) {
 
-            /* ...use CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE... */
-            wg_size_mult = ccl_kernel_get_workgroup_info_scalar(
-                krnl, dev, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE,
-                size_t, &err_internal);
-            ccl_if_err_not_info_unavailable_propagate_goto(
-                err, err_internal, error_handler);
+                /* ...use CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE... */
+                wg_size_mult = ccl_kernel_get_workgroup_info_scalar(
+                    krnl, dev, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE,
+                    size_t, &err_internal);
+                ccl_if_err_not_info_unavailable_propagate_goto(
+                    err, err_internal, error_handler);
 
-        } else {
+            } else {
 
-            /* ...otherwise just use CL_KERNEL_WORK_GROUP_SIZE. */
-            wg_size_mult = wg_size_max;
+                /* ...otherwise just use CL_KERNEL_WORK_GROUP_SIZE. */
+                wg_size_mult = wg_size_max;
 
-        }
+            }
 
 #else
 
-        wg_size_mult = wg_size_max;
+            wg_size_mult = wg_size_max;
 
 #endif
 
+            /* Cache the queried values if a free slot is available. */
+            if (slot >= 0) {
+                krnl->wg_cache[slot].wg_size_max = wg_size_max;
+                krnl->wg_cache[slot].wg_size_mult = wg_size_mult;
+                krnl->wg_cache[slot].device = dev_id;
+            }
+
+        }
+
     }
 
     /* If it was not possible to obtain wg_size_mult and wg_size_max, either
@@ -1177,7 +1901,7 @@ CCLWrapperInfo * ccl_kernel_get_arg_info(
     cl_kernel_arg_info param_name, CCLErr ** err) {
 
     /* Make sure krnl is not NULL. */
-    g_return_val_if_fail(krnl != NULL, NULL);
+    ccl_return_val_if_fail(krnl != NULL, NULL);
 
     /* Helper wrapper. */
     CCLWrapper fake_wrapper;
@@ -1209,6 +1933,18 @@ CCLWrapperInfo * ccl_kernel_get_arg_info(
 
 #else
 
+    /* Key of this (argument index, parameter) pair in the argument
+     * information cache. */
+    gint64 cache_key = (((gint64) idx) << 32) | param_name;
+
+    /* Argument information is immutable for a given kernel, so return
+     * it from the cache if this pair was queried before. */
+    if (krnl->arg_info_cache != NULL) {
+        info = g_hash_table_lookup(krnl->arg_info_cache, &cache_key);
+        if (info != NULL)
+            return info;
+    }
+
     /* Check that context platform is >= OpenCL 1.2 */
     ocl_ver = ccl_kernel_get_opencl_version(krnl, &err_internal);
     ccl_if_err_propagate_goto(err, err_internal, error_handler);
@@ -1222,12 +1958,23 @@ CCLWrapperInfo * ccl_kernel_get_arg_info(
     /* Wrap argument index in a fake cl_object. */
     fake_wrapper.cl_object = GUINT_TO_POINTER(idx);
 
-    /* Get kernel argument info. */
+    /* Get kernel argument info. The generic cache is bypassed, as it
+     * is keyed by parameter only; the result is kept in the argument
+     * information cache instead, keyed by index and parameter. */
     info = ccl_wrapper_get_info(
         (CCLWrapper *) krnl, &fake_wrapper, param_name, 0,
         CCL_INFO_KERNEL_ARG, CL_FALSE, &err_internal);
     ccl_if_err_propagate_goto(err, err_internal, error_handler);
 
+    /* Cache the information object. Its memory is owned by the
+     * wrapper information table and lives as long as the kernel. */
+    if (krnl->arg_info_cache == NULL)
+        krnl->arg_info_cache = g_hash_table_new_full(
+            g_int64_hash, g_int64_equal, g_free, NULL);
+    gint64 * key_copy = g_new(gint64, 1);
+    *key_copy = cache_key;
+    g_hash_table_insert(krnl->arg_info_cache, key_copy, info);
+
 #endif
 
     /* If we got here, everything is OK. */
@@ -1248,4 +1995,49 @@ finish:
     return info;
 }
 
+/**
+ * Get pointer to a kernel argument information value.
+ *
+ * This function should not be directly invoked in most circumstances. Use the
+ * ::ccl_kernel_get_arg_info_scalar() or ::ccl_kernel_get_arg_info_array()
+ * macros instead.
+ *
+ * @public @memberof ccl_kernel
+ * @see ccl_kernel_get_arg_info()
+ * @note Requires OpenCL >= 1.2
+ *
+ * @param[in] krnl The kernel wrapper object.
+ * @param[in] idx Argument index.
+ * @param[in] param_name Name of information/parameter to get value of.
+ * @param[in] min_size Minimum size of returned value in case of error.
+ * @param[out] err Return location for a ::CCLErr object, or `NULL` if error
+ * reporting is to be ignored.
+ * @return A pointer to the requested information value. This
+ * value will be automatically freed when the kernel wrapper object is
+ * destroyed. If an error occurs, either `NULL` (if `min_size == 0`), or
+ * a pointer to a `min_size`d zero value is returned (if `min_size > 0`).
+ * */
+CCL_EXPORT
+void * ccl_kernel_get_arg_info_value(CCLKernel * krnl, cl_uint idx,
+    cl_kernel_arg_info param_name, size_t min_size, CCLErr ** err) {
+
+    /* Make sure krnl is not NULL. */
+    g_return_val_if_fail(krnl != NULL, NULL);
+
+    /* Get information object, performing the underlying query only
+     * once. */
+    CCLWrapperInfo * info =
+        ccl_kernel_get_arg_info(krnl, idx, param_name, err);
+
+    /* In case of error, return an all-zeros value if min_size is > 0,
+     * so scalar accesses can dereference the result safely. */
+    if ((info == NULL) && (min_size > 0)) {
+        info = ccl_wrapper_info_new(min_size);
+        ccl_wrapper_add_info((CCLWrapper *) krnl, param_name, info);
+    }
+
+    /* Return value if information object is not NULL. */
+    return info != NULL ? info->value : NULL;
+}
+
 /** @} */
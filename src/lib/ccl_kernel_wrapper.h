@@ -139,6 +139,19 @@ void ccl_kernel_set_args(CCLKernel * krnl, ...) G_GNUC_NULL_TERMINATED;
 CCL_EXPORT
 void ccl_kernel_set_args_v(CCLKernel * krnl, void ** args);
 
+/* Forget all cached kernel argument state. */
+CCL_EXPORT
+void ccl_kernel_reset_arg_cache(CCLKernel * krnl);
+
+/* Enqueue a chain of kernels with minimal event dependencies, derived
+ * from the memory objects the kernels share. */
+CCL_EXPORT
+CCLEvent * ccl_kernel_chain_enqueue(CCLQueue * cq, CCLKernel ** krnls,
+    void *** args, cl_uint num_krnls, const cl_uint * work_dims,
+    const size_t ** global_work_offsets, const size_t ** global_work_sizes,
+    const size_t ** local_work_sizes, CCLEvent ** evts,
+    CCLEventWaitList * evt_wait_lst, CCLErr ** err);
+
 /* Enqueues a kernel for execution on a device. */
 CCL_EXPORT
 CCLEvent * ccl_kernel_enqueue_ndrange(CCLKernel * krnl, CCLQueue * cq,
@@ -146,6 +159,14 @@ CCLEvent * ccl_kernel_enqueue_ndrange(CCLKernel * krnl, CCLQueue * cq,
     const size_t * global_work_size, const size_t * local_work_size,
     CCLEventWaitList * evt_wait_lst, CCLErr ** err);
 
+/* Enqueues a kernel for execution on a device, without producing an
+ * event. */
+CCL_EXPORT
+cl_bool ccl_kernel_enqueue_ndrange_no_event(CCLKernel * krnl, CCLQueue * cq,
+    cl_uint work_dim, const size_t * global_work_offset,
+    const size_t * global_work_size, const size_t * local_work_size,
+    CCLEventWaitList * evt_wait_lst, CCLErr ** err);
+
 /* Set kernel arguments and enqueue it for execution. */
 CCL_EXPORT
 CCLEvent * ccl_kernel_set_args_and_enqueue_ndrange(CCLKernel * krnl,
@@ -322,6 +343,11 @@ CCL_EXPORT
 CCLWrapperInfo * ccl_kernel_get_arg_info(CCLKernel * krnl, cl_uint idx,
     cl_kernel_arg_info param_name, CCLErr ** err);
 
+/* Get pointer to a kernel argument information value. */
+CCL_EXPORT
+void * ccl_kernel_get_arg_info_value(CCLKernel * krnl, cl_uint idx,
+    cl_kernel_arg_info param_name, size_t min_size, CCLErr ** err);
+
 /**
  * Macro which returns a scalar kernel argument information
  * value.
@@ -344,11 +370,8 @@ CCLWrapperInfo * ccl_kernel_get_arg_info(CCLKernel * krnl, cl_uint idx,
  * */
 #define ccl_kernel_get_arg_info_scalar(krnl, idx, param_name, \
     param_type, err) \
-    (param_type) \
-    ((ccl_kernel_get_arg_info((krnl), (idx), (param_name), (err)) != NULL) \
-    ? **((param_type **) ccl_kernel_get_arg_info( \
-        (krnl), (idx), (param_name), (err))) \
-    : 0)
+    *((param_type *) ccl_kernel_get_arg_info_value((krnl), (idx), \
+        (param_name), sizeof(param_type), (err)))
 
 /**
  * Macro which returns an array kernel argument information value.
@@ -371,10 +394,8 @@ CCLWrapperInfo * ccl_kernel_get_arg_info(CCLKernel * krnl, cl_uint idx,
  * */
 #define ccl_kernel_get_arg_info_array(krnl, idx, param_name, \
     param_type, err) \
-    (ccl_kernel_get_arg_info((krnl), (idx), (param_name), (err)) != NULL) \
-    ? *((param_type **) ccl_kernel_get_arg_info( \
-        (krnl), (idx), (param_name), (err))) \
-    : NULL
+    (param_type *) ccl_kernel_get_arg_info_value((krnl), (idx), \
+        (param_name), 0, (err))
 
 /**
  * Increase the reference count of the kernel object.
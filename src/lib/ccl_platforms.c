@@ -26,6 +26,8 @@
  * @copyright [GNU Lesser General Public License version 3 (LGPLv3)](http://www.gnu.org/licenses/lgpl.html)
  * */
 
+#include <stdlib.h>
+
 #include "ccl_platforms.h"
 #include "_ccl_defs.h"
 
@@ -36,18 +38,59 @@
 struct ccl_platforms {
 
     /**
-     * Platforms available in the system.
+     * Number of platforms available in the system.
      * @private
      * */
-    CCLPlatform ** platfs;
+    cl_uint num_platfs;
 
     /**
-     * Number of platforms available in the system.
+     * Platforms available in the system. The array is embedded in the
+     * same allocation as the object itself.
      * @private
      * */
-    cl_uint num_platfs;
+    CCLPlatform * platfs[];
 };
 
+/**
+ * @internal
+ *
+ * @brief Size of the stack buffer used for the first, speculative
+ * clGetPlatformIDs() call. If the system has at most this many
+ * platforms (virtually always), count and IDs are obtained in a single
+ * ICD round-trip; otherwise a second call fetches the full list into a
+ * heap buffer.
+ */
+#define CCL_PLATFORMS_IDS_GUESS 8
+
+/**
+ * @internal
+ *
+ * @brief Process-wide cached platform IDs. On ICD-loader systems the
+ * first clGetPlatformIDs() call walks driver registries and dlopens
+ * vendor libraries, so the enumeration is performed once and later
+ * ccl_platforms_new() calls reuse the cached IDs. Only raw
+ * cl_platform_id values are cached, never wrapper objects: each
+ * ::CCLPlatforms object owns its wrappers, so destroying it releases
+ * them all, as documented, and ccl_wrapper_memcheck() stays
+ * meaningful.
+ */
+static cl_platform_id * ccl_platform_ids_cache = NULL;
+
+/* Number of platform IDs in the cache. */
+static cl_uint ccl_platform_ids_cache_num = 0;
+
+/* Lock for the cached platform IDs. */
+G_LOCK_DEFINE_STATIC(ccl_platform_ids_cache);
+
+/**
+ * @internal
+ *
+ * @brief Free the cached platform IDs at process shutdown.
+ */
+static void ccl_platforms_cache_shutdown(void) {
+    ccl_platforms_invalidate_cache();
+}
+
 /**
  * @addtogroup CCL_PLATFORMS
  * @{
@@ -76,41 +119,82 @@ CCLPlatforms * ccl_platforms_new(CCLErr ** err) {
      * in the system. */
     CCLPlatforms * platforms = NULL;
 
-    /* Size in bytes of array of platform IDs. */
-    gsize platf_ids_size;
+    /* Number of platforms available in the system. */
+    cl_uint num_platfs = 0;
+
+    /* Stack buffer for the speculative one-trip platform IDs fetch. */
+    cl_platform_id stack_ids[CCL_PLATFORMS_IDS_GUESS];
 
     /* Array of platform IDs. */
     cl_platform_id * platf_ids = NULL;
 
-    /* Allocate memory for the CCLPlatforms object. */
-    platforms = g_slice_new0(CCLPlatforms);
-
-    /* Get number of platforms */
-    ocl_status = clGetPlatformIDs(0, NULL, &platforms->num_platfs);
-    ccl_if_err_create_goto(*err, CCL_ERROR,
-        platforms->num_platfs == 0, CCL_ERROR_DEVICE_NOT_FOUND,
-        error_handler, "%s: no OpenCL platforms found.", CCL_STRD);
-    ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
-        CL_SUCCESS != ocl_status, ocl_status, error_handler,
-        "%s: get number of platforms (OpenCL error %d: %s).",
-        CCL_STRD, ocl_status, ccl_err(ocl_status));
-
-    /* Determine size in bytes of array of platform IDs. */
-    platf_ids_size = sizeof(cl_platform_id) * platforms->num_platfs;
-
-    /* Allocate memory for array of platform IDs. */
-    platf_ids = (cl_platform_id *) g_slice_alloc(platf_ids_size);
-
-    /* Get existing platform IDs. */
-    ocl_status = clGetPlatformIDs(platforms->num_platfs, platf_ids, NULL);
-    ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
-        CL_SUCCESS != ocl_status, ocl_status, error_handler,
-        "%s: get platforms IDs (OpenCL error %d: %s).",
-        CCL_STRD, ocl_status, ccl_err(ocl_status));
+    /* Was the array of platform IDs heap-allocated? */
+    gboolean platf_ids_on_heap = FALSE;
+
+    /* Was the enumeration served from the process-wide cache? */
+    gboolean from_cache = FALSE;
+
+    /* If cached platform IDs exist, copy them instead of asking the
+     * ICD again. */
+    G_LOCK(ccl_platform_ids_cache);
+    if (ccl_platform_ids_cache != NULL) {
+        num_platfs = ccl_platform_ids_cache_num;
+        if (num_platfs <= CCL_PLATFORMS_IDS_GUESS) {
+            platf_ids = stack_ids;
+        } else {
+            platf_ids = g_new(cl_platform_id, num_platfs);
+            platf_ids_on_heap = TRUE;
+        }
+        for (guint i = 0; i < num_platfs; i++)
+            platf_ids[i] = ccl_platform_ids_cache[i];
+        from_cache = TRUE;
+    }
+    G_UNLOCK(ccl_platform_ids_cache);
+
+    if (!from_cache) {
+
+        /* Speculatively fetch platform IDs into the stack buffer. Per
+         * the OpenCL specification, clGetPlatformIDs() always returns
+         * the full platform count in its last argument, even when
+         * num_entries is smaller — so on the (virtually universal)
+         * systems with at most CCL_PLATFORMS_IDS_GUESS platforms, count
+         * and IDs are obtained in a single ICD round-trip. */
+        ocl_status = clGetPlatformIDs(
+            CCL_PLATFORMS_IDS_GUESS, stack_ids, &num_platfs);
+        ccl_if_err_create_goto(*err, CCL_ERROR,
+            num_platfs == 0, CCL_ERROR_DEVICE_NOT_FOUND,
+            error_handler, "%s: no OpenCL platforms found.", CCL_STRD);
+        ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
+            CL_SUCCESS != ocl_status, ocl_status, error_handler,
+            "%s: get platforms IDs (OpenCL error %d: %s).",
+            CCL_STRD, ocl_status, ccl_err(ocl_status));
+
+        if (num_platfs <= CCL_PLATFORMS_IDS_GUESS) {
+
+            /* The guess was large enough; the stack buffer holds all
+             * IDs. */
+            platf_ids = stack_ids;
+
+        } else {
+
+            /* More platforms than guessed: fetch the full list into a
+             * heap buffer, now that the exact count is known. */
+            platf_ids = g_new(cl_platform_id, num_platfs);
+            platf_ids_on_heap = TRUE;
+
+            ocl_status = clGetPlatformIDs(num_platfs, platf_ids, NULL);
+            ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
+                CL_SUCCESS != ocl_status, ocl_status, error_handler,
+                "%s: get platforms IDs (OpenCL error %d: %s).",
+                CCL_STRD, ocl_status, ccl_err(ocl_status));
+        }
+    }
 
-    /* Allocate memory for array of platform wrapper objects. */
-    platforms->platfs =
-        g_slice_alloc(sizeof(CCLPlatform *) * platforms->num_platfs);
+    /* Allocate memory for the CCLPlatforms object and the embedded
+     * array of platform wrapper objects, in a single block. */
+    platforms = g_malloc0(
+        sizeof(CCLPlatforms) + num_platfs * sizeof(CCLPlatform *));
+    platforms->num_platfs = num_platfs;
 
     /* Wrap platform IDs in platform wrapper objects. */
     for (guint i = 0; i < platforms->num_platfs; i++) {
@@ -118,8 +202,25 @@ CCLPlatforms * ccl_platforms_new(CCLErr ** err) {
         platforms->platfs[i] = ccl_platform_new_wrap(platf_ids[i]);
     }
 
-    /* Free array of platform ids. */
-    g_slice_free1(platf_ids_size, platf_ids);
+    /* Cache the enumerated IDs, so later calls skip the ICD walk,
+     * unless another thread cached its own enumeration in the
+     * meantime. The cache is freed at process shutdown or by
+     * ccl_platforms_invalidate_cache(). */
+    if (!from_cache) {
+        G_LOCK(ccl_platform_ids_cache);
+        if (ccl_platform_ids_cache == NULL) {
+            static gboolean atexit_registered = FALSE;
+            ccl_platform_ids_cache = g_new(cl_platform_id, num_platfs);
+            ccl_platform_ids_cache_num = num_platfs;
+            for (guint i = 0; i < num_platfs; i++)
+                ccl_platform_ids_cache[i] = platf_ids[i];
+            if (!atexit_registered) {
+                atexit(ccl_platforms_cache_shutdown);
+                atexit_registered = TRUE;
+            }
+        }
+        G_UNLOCK(ccl_platform_ids_cache);
+    }
 
     /* If we got here, everything is OK. */
     g_assert(err == NULL || *err == NULL);
@@ -130,15 +231,17 @@ error_handler:
     /* If we got here there was an error, verify that it is so. */
     g_assert(err == NULL || *err != NULL);
 
-    /* Destroy the CCLPlatforms object (no need to check for NULL since to get
-     * here, the object must have been created). */
-    ccl_platforms_destroy(platforms);
+    /* Destroy the CCLPlatforms object, if it was created. */
+    if (platforms != NULL) ccl_platforms_destroy(platforms);
 
     /* Set platforms to NULL, indicating an error occurred.*/
     platforms = NULL;
 
 finish:
 
+    /* Free array of platform ids, if it was heap-allocated. */
+    if (platf_ids_on_heap) g_free(platf_ids);
+
     /* Return the CCLPlatforms object. */
     return platforms;
 }
@@ -162,12 +265,30 @@ void ccl_platforms_destroy(CCLPlatforms * platforms) {
         ccl_platform_unref(platforms->platfs[i]);
     }
 
-    /* Free underlying platforms array. */
-    g_slice_free1(
-        sizeof(CCLPlatform *) * platforms->num_platfs, platforms->platfs);
+    /* Free CCLPlatforms object, including the embedded array of
+     * platform wrapper objects. */
+    g_free(platforms);
+}
 
-    /* Free CCLPlatforms object. */
-    g_slice_free(CCLPlatforms, platforms);
+/**
+ * Invalidate the process-wide cached platform enumeration.
+ *
+ * The next call to ::ccl_platforms_new() will enumerate the platforms
+ * again. Use this if the set of available platforms may have changed,
+ * e.g. after a driver reload. Objects previously returned by
+ * ::ccl_platforms_new() remain valid until destroyed.
+ *
+ * @public @memberof ccl_platforms
+ * */
+CCL_EXPORT
+void ccl_platforms_invalidate_cache(void) {
+
+    /* Free the cached platform IDs. */
+    G_LOCK(ccl_platform_ids_cache);
+    g_free(ccl_platform_ids_cache);
+    ccl_platform_ids_cache = NULL;
+    ccl_platform_ids_cache_num = 0;
+    G_UNLOCK(ccl_platform_ids_cache);
 }
 
 /**
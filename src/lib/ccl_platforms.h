@@ -79,6 +79,10 @@ CCLPlatforms * ccl_platforms_new(CCLErr ** err);
 CCL_EXPORT
 void ccl_platforms_destroy(CCLPlatforms * platforms);
 
+/* Invalidate the process-wide cached platform enumeration. */
+CCL_EXPORT
+void ccl_platforms_invalidate_cache(void);
+
 /* Return number of OpenCL platforms found in CCLPlatforms*
  * object. */
 CCL_EXPORT
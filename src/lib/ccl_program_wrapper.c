@@ -426,6 +426,20 @@ CCLProgram * ccl_program_new_from_sources(CCLContext * ctx,
     cl_program program = NULL;
     CCLProgram * prg = NULL;
 
+    /* Reject invalid source arguments before reaching the driver. The
+     * OpenCL specification mandates CL_INVALID_VALUE for these, but
+     * some implementations dereference the strings first. */
+    ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
+        (count == 0) || (strings == NULL), CL_INVALID_VALUE, error_handler,
+        "%s: no source strings given (OpenCL error %d: %s).",
+        CCL_STRD, CL_INVALID_VALUE, ccl_err(CL_INVALID_VALUE));
+    for (cl_uint i = 0; i < count; ++i) {
+        ccl_if_err_create_goto(*err, CCL_OCL_ERROR,
+            strings[i] == NULL, CL_INVALID_VALUE, error_handler,
+            "%s: source string %d is NULL (OpenCL error %d: %s).",
+            CCL_STRD, i, CL_INVALID_VALUE, ccl_err(CL_INVALID_VALUE));
+    }
+
     /* Build program from sources. */
     program = clCreateProgramWithSource(
         ccl_context_unwrap(ctx), count, strings, lengths, &ocl_status);
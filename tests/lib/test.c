@@ -27,6 +27,7 @@
  * */
 
 #include "test.h"
+#include <glib/gstdio.h>
 #include "_ccl_defs.h"
 
 /**
@@ -205,3 +206,126 @@ finish:
     /* Return the context. */
     return ctx;
 }
+
+/**
+ * @internal
+ *
+ * @brief Create a built program from source, caching the program binary
+ * on disk so that repeated test runs skip the driver compiler.
+ *
+ * The cache file lives in the system temporary directory and is keyed on
+ * the MD5 of the source and the MD5 of the device name plus driver
+ * version. The key therefore self-invalidates when the kernel source is
+ * edited or the driver is updated. A stale or corrupt cache entry is
+ * discarded and the program is silently rebuilt from source.
+ *
+ * @param[in] ctx Context in which to create the program. The cache is
+ * keyed on the first device in this context.
+ * @param[in] src Program source code.
+ * @param[out] err Error handling object.
+ * @return A built program wrapper, or `NULL` if an error occurs.
+ * */
+CCLProgram * ccl_test_program_new_cached(
+    CCLContext * ctx, const char * src, CCLErr ** err) {
+
+    /* Make sure there is no error set. */
+    g_assert_no_error(*err);
+
+    /* Program wrapper. */
+    CCLProgram * prg = NULL;
+
+    /* Device on which the cache is keyed. */
+    CCLDevice * dev = NULL;
+
+    /* Internal error reporting object. */
+    CCLErr * err_internal = NULL;
+
+    /* Device name and driver version. */
+    char * dev_name;
+    char * drv_ver;
+
+    /* Cache key components and cache file location. */
+    gchar * src_md5 = NULL;
+    gchar * dev_sig = NULL;
+    gchar * dev_md5 = NULL;
+    gchar * cache_path = NULL;
+
+    /* Get first device in context. */
+    dev = ccl_context_get_device(ctx, 0, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Get device name and driver version, which key the cache together
+     * with the source. */
+    dev_name = ccl_device_get_info_array(
+        dev, CL_DEVICE_NAME, char, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+    drv_ver = ccl_device_get_info_array(
+        dev, CL_DRIVER_VERSION, char, &err_internal);
+    ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+    /* Determine the cache file location. */
+    src_md5 = g_compute_checksum_for_string(G_CHECKSUM_MD5, src, -1);
+    dev_sig = g_strdup_printf("%s|%s", dev_name, drv_ver);
+    dev_md5 = g_compute_checksum_for_string(G_CHECKSUM_MD5, dev_sig, -1);
+    cache_path = g_strdup_printf("%s%ccf4ocl2_test_%s_%s.bin",
+        g_get_tmp_dir(), G_DIR_SEPARATOR, src_md5, dev_md5);
+
+    /* Try to create the program from a previously cached binary. */
+    if (g_file_test(cache_path, G_FILE_TEST_IS_REGULAR)) {
+
+        prg = ccl_program_new_from_binary_file(
+            ctx, dev, cache_path, NULL, &err_internal);
+        if (err_internal == NULL)
+            ccl_program_build(prg, NULL, &err_internal);
+
+        /* A stale or corrupt cache entry is discarded; the program will
+         * be rebuilt from source below. */
+        if (err_internal != NULL) {
+            g_clear_error(&err_internal);
+            if (prg) {
+                ccl_program_destroy(prg);
+                prg = NULL;
+            }
+            g_unlink(cache_path);
+        }
+    }
+
+    /* Cache miss: build from source and cache the resulting binary. */
+    if (prg == NULL) {
+
+        prg = ccl_program_new_from_source(ctx, src, &err_internal);
+        ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+        ccl_program_build(prg, NULL, &err_internal);
+        ccl_if_err_propagate_goto(err, err_internal, error_handler);
+
+        /* Failing to write the cache only costs time on the next run, so
+         * any error is ignored. */
+        ccl_program_save_binary(prg, dev, cache_path, &err_internal);
+        g_clear_error(&err_internal);
+    }
+
+    /* If we got here, everything is OK. */
+    g_assert_true(err == NULL || *err == NULL);
+    goto finish;
+
+error_handler:
+
+    /* If we got here there was an error, verify that it is so. */
+    g_assert_true(err == NULL || *err != NULL);
+    if (prg) {
+        ccl_program_destroy(prg);
+        prg = NULL;
+    }
+
+finish:
+
+    /* Free cache key strings. */
+    g_free(src_md5);
+    g_free(dev_sig);
+    g_free(dev_md5);
+    g_free(cache_path);
+
+    /* Return the program. */
+    return prg;
+}
@@ -48,3 +48,8 @@ CCLContext * ccl_test_context_new(cl_uint min_ocl_ver, CCLErr ** err);
  * OpenCL version. */
 CCLContext * ccl_test_context_new_with_image_support(
     cl_uint min_ocl_ver, CCLErr ** err);
+
+/* Create a built program from source, caching the program binary on disk
+ * so that repeated test runs skip the driver compiler. */
+CCLProgram * ccl_test_program_new_cached(
+    CCLContext * ctx, const char * src, CCLErr ** err);
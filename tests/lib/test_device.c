@@ -141,6 +141,12 @@ static void sub_devices_test() {
         pdev, CL_DEVICE_PARTITION_MAX_SUB_DEVICES, cl_uint, &err);
     g_assert_no_error(err);
 
+    /* Get the formatting function for partition properties. The map
+     * lookup involves string comparisons, so it is done once here and
+     * reused by both per-sub-device loops below. */
+    format_func = ccl_devquery_info_map[
+        ccl_devquery_get_index("PARTITION_TYPE")].format;
+
     /* Test partition equally, if supported by device. */
     supported = CL_FALSE;
     for (i = 0; dpp[i] != 0; ++i) {
@@ -164,6 +170,10 @@ static void sub_devices_test() {
             pdev, eqprop, &num_subdevs, &err);
         g_assert_no_error(err);
 
+        /* Render the expected per-sub-device CU count once; it is the
+         * same for every sub-device in an equal partition. */
+        g_snprintf(aux, aux_len, "%d", cu);
+
         /* Check sub-devices. */
         for (i = 0; i < num_subdevs; ++i) {
 
@@ -194,15 +204,15 @@ static void sub_devices_test() {
             g_assert_cmpuint( /* Check number of CUs in each device */
                     ((cl_device_partition_property *) info->value)[1], ==, cu);
 
-            /* Test device query function for formatting partition
-             * properties. */
+        }
 
-            format_func = /* Get formatting function. */
-                ccl_devquery_info_map[
-                    ccl_devquery_get_index("PARTITION_TYPE")].format;
+        /* Test device query function for formatting partition
+         * properties. Every sub-device reports the same partition
+         * info, so formatting is checked once, on the last queried
+         * info object. */
+        if (num_subdevs > 0) {
             format_func(info, out, CCL_TEST_DEVQUERY_MAXINFOLEN, "");
             g_assert_true(g_strrstr(out, "EQUALLY") != NULL);
-            g_snprintf(aux, aux_len, "%d", cu);
             g_assert_true(g_strrstr(out, aux) != NULL); /* Check number of CUs */
         }
 
@@ -221,7 +231,10 @@ static void sub_devices_test() {
     }
     if (supported) {
 
-        /* Allocate partition properties array and initialize it. */
+        /* Allocate partition properties array. Its size is
+         * device-reported, so it comes from the slice allocator — a
+         * variable-length array would be unbounded stack usage and is
+         * not supported by MSVC. */
         cl_device_partition_property * ctprop = g_slice_alloc0(
             (max_subdevs + 3) * sizeof(cl_device_partition_property));
         ctprop[0] = CL_DEVICE_PARTITION_BY_COUNTS;
@@ -282,12 +295,12 @@ static void sub_devices_test() {
                     ctprop[j]);
             }
 
-            /* Test device query function for formatting partition
-             * properties. */
+        }
 
-            format_func = /* Get formatting function. */
-                ccl_devquery_info_map[
-                    ccl_devquery_get_index("PARTITION_TYPE")].format;
+        /* Test device query function for formatting partition
+         * properties. As above, the formatted output is identical for
+         * every sub-device, so one check suffices. */
+        if (num_subdevs > 0) {
             format_func(info, out, CCL_TEST_DEVQUERY_MAXINFOLEN, "");
             g_assert_true(g_strrstr(out, "BY_COUNTS") != NULL);
             for (guint j = 1;
@@ -304,14 +317,13 @@ static void sub_devices_test() {
          * expected. */
         g_assert_cmpuint(total_cu_check, ==, total_cu);
 
+        /* Free partition properties array. */
+        g_slice_free1(
+            (max_subdevs + 3) * sizeof(cl_device_partition_property), ctprop);
+
         /* Check that the last position is NULL. */
         g_assert_cmphex(
             GPOINTER_TO_SIZE(subdevs[i]), ==, GPOINTER_TO_SIZE(NULL));
-
-        /* Release memory associated with partition properties array. */
-        g_slice_free1(
-            (max_subdevs + 3) * sizeof(cl_device_partition_property),
-            ctprop);
     }
 
     /* Confirm that memory allocated by wrappers has not yet been freed. */
@@ -74,6 +74,19 @@ static void name_test() {
     /* Test not found parameter name. */
     info = ccl_devquery_name("MOCK_PARAM_THAT_DOES_NOT_EXIST");
     g_assert_cmphex(info, ==, 0);
+
+    /* Test direct lookup by cl_device_info value. */
+    const CCLDevQueryMap * row;
+    row = ccl_devquery_by_enum(CL_DEVICE_ENDIAN_LITTLE);
+    g_assert_nonnull(row);
+    g_assert_cmpstr(row->param_name, ==, "ENDIAN_LITTLE");
+    row = ccl_devquery_by_enum(CL_DRIVER_VERSION);
+    g_assert_nonnull(row);
+    g_assert_cmphex(row->device_info, ==, CL_DRIVER_VERSION);
+
+    /* Test direct lookup of a value not present in the map. */
+    row = ccl_devquery_by_enum(0xFFFFFFF);
+    g_assert_null(row);
 }
 
 /**